@@ -144,4 +144,18 @@ mv assets/graphics/effects/Zapped1.cel CD/Assets/Graphics/Effects/
 mv assets/graphics/effects/Zapped2.cel CD/Assets/Graphics/Effects/
 
 3it to-cel -b 8 --coded true assets/graphics/effects/zapped3.bmp -o assets/graphics/effects/Zapped3.cel
-mv assets/graphics/effects/Zapped3.cel CD/Assets/Graphics/Effects/
\ No newline at end of file
+mv assets/graphics/effects/Zapped3.cel CD/Assets/Graphics/Effects/
+
+# join enemy and effect frames, in the order load_enemy_anims reads them
+
+GP="CD/Assets/Graphics"
+
+cat $GP/Missile/Missile1.cel $GP/Missile/Missile2.cel $GP/Missile/Missile3.cel \
+    $GP/Flipper/Flipper1.cel \
+    $GP/Tanker/Tanker1.cel $GP/Tanker/Tanker2.cel $GP/Tanker/Tanker3.cel \
+    $GP/Spiker/Spiker1.cel \
+    $GP/Fuseball/Fuseball1.cel $GP/Fuseball/Fuseball2.cel $GP/Fuseball/Fuseball3.cel \
+    $GP/Pulsar/Pulsar1.cel \
+    $GP/Ftanker/Ftanker1.cel $GP/Ftanker/Ftanker2.cel $GP/Ftanker/Ftanker3.cel \
+    $GP/Ptanker/Ptanker1.cel $GP/Ptanker/Ptanker2.cel $GP/Ptanker/Ptanker3.cel \
+    $GP/Effects/Zapped1.cel $GP/Effects/Zapped2.cel $GP/Effects/Zapped3.cel > $GP/Enemies.cel
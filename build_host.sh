@@ -0,0 +1,57 @@
+#!/bin/sh
+
+# Builds the engine checks in tools/host with the system compiler and runs them.
+# Usage: build_host.sh [folio log] [capture file]
+# A folioref_dump log also compares against the math folio, pass "" to skip it.
+# A capture from tools/capture_extract.py is timed instead of the built frame.
+# Run from the repository root, the game checks load levels and cels from CD.
+
+CC=${CC:-cc}
+CFLAGS="-std=gnu89 -O2 -DFIXMATH_PORTABLE -Itools/host/sdk -Isource/includes -Isource/game/includes"
+OUT=tools/host/bin
+
+mkdir -p $OUT
+
+$CC $CFLAGS -o $OUT/fixmath_check tools/host/fixmath_check.c source/fixmath.c source/folioref.c || exit 1
+
+$OUT/fixmath_check $1 || exit 1
+
+$CC $CFLAGS -o $OUT/trig_check tools/host/trig_check.c source/trig.c source/trig_lut.c source/folioref.c -lm || exit 1
+
+$OUT/trig_check $1 || exit 1
+
+ENGINE="source/threed.c source/rqueue.c source/dlist.c source/maths.c source/cel_helper.c source/trig.c source/trig_lut.c source/fixmath.c tools/host/host3do.c tools/host/host_game.c"
+
+$CC $CFLAGS -o $OUT/edges_check tools/host/edges_check.c $ENGINE || exit 1
+
+$OUT/edges_check || exit 1
+
+$CC $CFLAGS -DSOFTCEL -o $OUT/softcel_bench tools/host/softcel_bench.c source/softcel.c source/capture.c source/celcost.c $ENGINE || exit 1
+
+$OUT/softcel_bench $2 || exit 1
+
+$CC $CFLAGS -DRQUEUE_BUDGET=1024 -o $OUT/sort_bench tools/host/sort_bench.c $ENGINE || exit 1
+
+$OUT/sort_bench || exit 1
+
+$CC $CFLAGS -o $OUT/project_check tools/host/project_check.c $ENGINE || exit 1
+
+$OUT/project_check || exit 1
+
+$CC $CFLAGS -o $OUT/euler_check tools/host/euler_check.c $ENGINE || exit 1
+
+$OUT/euler_check || exit 1
+
+GAME="source/game/corridors.c source/game/enemies.c source/pool.c source/stimers.c tools/host/host_play.c"
+
+$CC $CFLAGS -Itools/host -DMAX_ENEMIES=64 -DMAX_SPIKES=20 -o $OUT/corridor_check tools/host/corridor_check.c $GAME $ENGINE || exit 1
+
+$OUT/corridor_check || exit 1
+
+$CC $CFLAGS -Itools/host -DMAX_ENEMIES=48 -o $OUT/index_bench tools/host/index_bench.c $GAME $ENGINE || exit 1
+
+$OUT/index_bench || exit 1
+
+$CC $CFLAGS -Itools/host -DPROFILE_STRESS -o $OUT/stress_check tools/host/stress_check.c $GAME $ENGINE || exit 1
+
+$OUT/stress_check || exit 1
@@ -0,0 +1,519 @@
+#include "capture.h"
+#include "dlist.h"
+#include "cel_helper.h"
+
+// 3DO includes
+#include "stdio.h"
+#include "string.h"
+#include "mem.h"
+
+#define DUMP_WORDS_PER_LINE 8
+
+#define SWAP32(v) ((((v) & 0xFF) << 24) | (((v) & 0xFF00) << 8) | (((v) >> 8) & 0xFF00) | (((v) >> 24) & 0xFF))
+#define SWAP16(v) ((uint16) ((((v) & 0xFF) << 8) | (((v) >> 8) & 0xFF)))
+
+/* *************************************************************************************** */
+/* ==================================== PRIVATE VARS ===================================== */
+/* *************************************************************************************** */
+
+static ubyte *buffer = NULL;
+static uint32 kept_size;    // Zero when no frame is kept
+static uint32 kept_cost;
+
+// Built by the first pass of a capture
+static CCB *ccb_ptrs[CAPTURE_MAX_CCBS];
+static uint32 ccb_layers[CAPTURE_MAX_CCBS];
+static uint32 ccb_count;
+static void *chunk_ptrs[CAPTURE_MAX_CHUNKS];
+static capture_chunk_typ chunks[CAPTURE_MAX_CHUNKS];
+static uint32 chunk_count;
+static uint32 data_size;
+static Boolean chunks_full;
+
+/* *************************************************************************************** */
+/* ========================== PRIVATE FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+/*  Bytes of source data, preamble included when it is not in the CCB. Returns CAPTURE_NONE
+    if the cel reads past limit bytes, no more than limit bytes are read to find out. */
+static uint32 get_source_size(CCB *ccb, uint32 limit)
+{
+    uint32 *words = (uint32*) ccb->ccb_SourcePtr;
+    uint32 pre0, pre1;
+    uint32 bpp, rows, offset;
+    uint32 i, size = 0;
+
+    if (ccb->ccb_Flags & CCB_CCBPRE)
+    {
+        pre0 = ccb->ccb_PRE0;
+        pre1 = ccb->ccb_PRE1;
+    }
+    else
+    {
+        size = (ccb->ccb_Flags & CCB_PACKED) ? 4 : 8;
+
+        if (size > limit)
+            return(CAPTURE_NONE);
+
+        pre0 = words[0];
+        pre1 = (ccb->ccb_Flags & CCB_PACKED) ? 0 : words[1];
+    }
+
+    bpp = (pre0 & PRE0_BPP_MASK) >> PRE0_BPP_SHIFT;
+    rows = ((pre0 & PRE0_VCNT_MASK) >> PRE0_VCNT_SHIFT) + PRE0_VCNT_PREFETCH;
+
+    if (ccb->ccb_Flags & CCB_PACKED)
+    {
+        // Each row starts with the word offset to the next row, minus 2
+        words += size >> 2;
+
+        for (i = 0; i < rows; i++)
+        {
+            if (size + 4 > limit)
+                return(CAPTURE_NONE);
+
+            if (bpp >= PRE0_BPP_8)
+                offset = (words[0] >> 16) & 0x3FF;
+            else
+                offset = words[0] >> 24;
+
+            offset += PRE1_WOFFSET_PREFETCH;
+            words += offset;
+            size += offset << 2;
+        }
+
+        return((size > limit) ? CAPTURE_NONE : size);
+    }
+
+    if (bpp >= PRE0_BPP_8)
+        offset = (pre1 & PRE1_WOFFSET10_MASK) >> PRE1_WOFFSET10_SHIFT;
+    else
+        offset = (pre1 & PRE1_WOFFSET8_MASK) >> PRE1_WOFFSET8_SHIFT;
+
+    size += rows * ((offset + PRE1_WOFFSET_PREFETCH) << 2);
+
+    return((size > limit) ? CAPTURE_NONE : size);
+}
+
+// Offset of ptr in the data, adding a chunk the first time it is seen
+static uint32 find_chunk(void *ptr, uint32 size, uint32 kind)
+{
+    uint32 i;
+
+    for (i = 0; i < chunk_count; i++)
+    {
+        if (chunk_ptrs[i] == ptr && chunks[i].kind == kind)
+            return(chunks[i].offset);
+    }
+
+    if (chunk_count >= CAPTURE_MAX_CHUNKS)
+    {
+        chunks_full = TRUE;
+        return(CAPTURE_NONE);
+    }
+
+    chunk_ptrs[chunk_count] = ptr;
+    chunks[chunk_count].offset = data_size;
+    chunks[chunk_count].size = size;
+    chunks[chunk_count].kind = kind;
+    chunk_count++;
+
+    data_size += (size + 3) & ~3;
+
+    return(chunks[chunk_count - 1].offset);
+}
+
+// First pass, gather the CCBs and the data they point to
+static Boolean gather_layers(void)
+{
+    uint32 i;
+    dlist_layer_typ_ptr lptr;
+    CCB *ccb;
+
+    ccb_count = 0;
+    chunk_count = 0;
+    data_size = 0;
+    chunks_full = FALSE;
+
+    for (i = 0; i < DLIST_MAX_LAYERS; i++)
+    {
+        lptr = dlist_get_layer(i);
+
+        if (lptr->hidden || !lptr->first)
+            continue;
+
+        for (ccb = lptr->first; ccb; ccb = ccb->ccb_NextPtr)
+        {
+            if (ccb_count >= CAPTURE_MAX_CCBS)
+                return(FALSE);
+
+            ccb_ptrs[ccb_count] = ccb;
+            ccb_layers[ccb_count] = i;
+            ccb_count++;
+
+            if (ccb == lptr->last)
+                break;
+        }
+    }
+
+    return(TRUE);
+}
+
+static void write_record(capture_ccb_typ_ptr rec, uint32 index)
+{
+    CCB *ccb = ccb_ptrs[index];
+
+    rec->layer = ccb_layers[index];
+    rec->next = (index + 1 < ccb_count) ? index + 1 : CAPTURE_NONE;
+    rec->source = CAPTURE_NONE;
+    rec->plut = CAPTURE_NONE;
+
+    // The game only uses absolute pointers, see cel_helper.c
+    if (ccb->ccb_SourcePtr)
+        rec->source = find_chunk((void*) ccb->ccb_SourcePtr, get_source_size(ccb, CAPTURE_NONE), CAPTURE_CHUNK_SOURCE);
+
+    // A PLUT stays loaded until the next CCB_LDPLUT, so only those are kept
+    if (ccb->ccb_PLUTPtr && (ccb->ccb_Flags & CCB_LDPLUT))
+        rec->plut = find_chunk(ccb->ccb_PLUTPtr, 32 * sizeof(uint16), CAPTURE_CHUNK_PLUT);
+
+    rec->flags = ccb->ccb_Flags;
+    rec->x_pos = ccb->ccb_XPos;
+    rec->y_pos = ccb->ccb_YPos;
+    rec->hdx = ccb->ccb_HDX;
+    rec->hdy = ccb->ccb_HDY;
+    rec->vdx = ccb->ccb_VDX;
+    rec->vdy = ccb->ccb_VDY;
+    rec->hddx = ccb->ccb_HDDX;
+    rec->hddy = ccb->ccb_HDDY;
+    rec->pixc = ccb->ccb_PIXC;
+    rec->pre0 = ccb->ccb_PRE0;
+    rec->pre1 = ccb->ccb_PRE1;
+    rec->width = ccb->ccb_Width;
+    rec->height = ccb->ccb_Height;
+}
+
+// Chunk of the given kind starting at offset, NULL if there is none
+static capture_chunk_typ_ptr find_loaded_chunk(capture_chunk_typ_ptr table, uint32 count, uint32 offset, uint32 kind)
+{
+    uint32 i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (table[i].offset == offset && table[i].kind == kind)
+            return(&table[i]);
+    }
+
+    return(NULL);
+}
+
+static void swap_words(uint32 *words, uint32 count)
+{
+    uint32 i;
+
+    for (i = 0; i < count; i++)
+        words[i] = SWAP32(words[i]);
+}
+
+/* *************************************************************************************** */
+/* =========================== PUBLIC FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+Boolean capture_init(void)
+{
+    if (!buffer)
+        buffer = (ubyte*) AllocMem(CAPTURE_BUFFER_SIZE, MEMTYPE_DRAM);
+
+    #if DEBUG_MODE
+        if (!buffer)
+            printf("Error - Could not allocate capture buffer.\n");
+    #endif
+
+    kept_size = 0;
+    kept_cost = 0;
+
+    return(buffer != NULL);
+}
+
+void capture_free(void)
+{
+    if (buffer)
+        FreeMem(buffer, CAPTURE_BUFFER_SIZE);
+
+    buffer = NULL;
+    kept_size = 0;
+}
+
+Boolean capture_frame(uint32 frame, uint32 cost)
+{
+    uint32 i, size;
+    capture_header_typ_ptr header;
+    capture_ccb_typ_ptr records;
+    capture_chunk_typ_ptr table;
+    ubyte *data;
+
+    if (!buffer || (kept_size && cost <= kept_cost))
+        return(FALSE);
+
+    // Records are written before the chunks are known, they must fit on their own
+    if (!gather_layers() || sizeof(capture_header_typ) + ccb_count * sizeof(capture_ccb_typ) > CAPTURE_BUFFER_SIZE)
+        return(FALSE);
+
+    header = (capture_header_typ_ptr) buffer;
+    records = (capture_ccb_typ_ptr) (buffer + sizeof(capture_header_typ));
+
+    // Records are written first since they find the chunks, the kept frame is lost from here
+    for (i = 0; i < ccb_count; i++)
+        write_record(&records[i], i);
+
+    table = (capture_chunk_typ_ptr) &records[ccb_count];
+    data = (ubyte*) &table[chunk_count];
+    size = (uint32) (data - buffer) + data_size;
+
+    if (chunks_full || size > CAPTURE_BUFFER_SIZE)
+    {
+        #if DEBUG_MODE
+            printf("Error - Frame %d does not fit the capture buffer.\n", frame);
+        #endif
+
+        kept_size = 0;
+        return(FALSE);
+    }
+
+    memcpy((void*)table, (void*)chunks, sizeof(capture_chunk_typ) * chunk_count);
+
+    for (i = 0; i < chunk_count; i++)
+        memcpy((void*)(data + chunks[i].offset), chunk_ptrs[i], chunks[i].size);
+
+    header->magic = CAPTURE_MAGIC;
+    header->version = CAPTURE_VERSION;
+    header->frame = frame;
+    header->cost = cost;
+    header->ccb_count = ccb_count;
+    header->chunk_count = chunk_count;
+    header->data_size = data_size;
+
+    kept_size = size;
+    kept_cost = cost;
+
+    return(TRUE);
+}
+
+void capture_dump(void)
+{
+    uint32 i;
+    uint32 *words = (uint32*) buffer;
+    capture_header_typ_ptr header = (capture_header_typ_ptr) buffer;
+
+    if (!kept_size)
+    {
+        printf("CAPF NONE\n");
+        return;
+    }
+
+    printf("CAPF BEGIN %d %d %d\n", kept_size, header->frame, header->cost);
+
+    for (i = 0; i < kept_size >> 2; i++)
+    {
+        if (i % DUMP_WORDS_PER_LINE == 0)
+            printf("CAPF %06x", i << 2);
+
+        printf(" %08x", words[i]);
+
+        if (i % DUMP_WORDS_PER_LINE == DUMP_WORDS_PER_LINE - 1)
+            printf("\n");
+    }
+
+    if (i % DUMP_WORDS_PER_LINE)
+        printf("\n");
+
+    printf("CAPF END\n");
+}
+
+void *capture_kept(uint32 *size)
+{
+    *size = kept_size;
+
+    return(kept_size ? (void*) buffer : NULL);
+}
+
+CCB *capture_load(void *data, uint32 size, CCB *ccbs, uint32 max_ccbs, uint32 *layers)
+{
+    uint32 i, j, tables_size;
+    uint16 *plut;
+    Boolean swapped = FALSE;
+    capture_header_typ_ptr header = (capture_header_typ_ptr) data;
+    capture_ccb_typ_ptr records, rec;
+    capture_chunk_typ_ptr table, chunk;
+    ubyte *source;
+    CCB *ccb;
+
+    if (size < sizeof(capture_header_typ))
+        return(NULL);
+
+    // Made on a machine of the other byte order
+    if (header->magic == SWAP32(CAPTURE_MAGIC))
+    {
+        swap_words((uint32*) header, sizeof(capture_header_typ) >> 2);
+        swapped = TRUE;
+    }
+
+    if (header->magic != CAPTURE_MAGIC || header->version != CAPTURE_VERSION || header->ccb_count == 0 ||
+        header->ccb_count > max_ccbs || header->chunk_count > CAPTURE_MAX_CHUNKS)
+    {
+        return(NULL);
+    }
+
+    // Counts are bounded above, so this cannot wrap
+    tables_size = sizeof(capture_header_typ) + header->ccb_count * sizeof(capture_ccb_typ) + 
+        header->chunk_count * sizeof(capture_chunk_typ);
+
+    if (tables_size > size || header->data_size > size - tables_size)
+        return(NULL);
+
+    records = (capture_ccb_typ_ptr) (header + 1);
+    table = (capture_chunk_typ_ptr) &records[header->ccb_count];
+    source = (ubyte*) &table[header->chunk_count];
+
+    if (swapped)
+    {
+        swap_words((uint32*) records, header->ccb_count * (sizeof(capture_ccb_typ) >> 2));
+        swap_words((uint32*) table, header->chunk_count * (sizeof(capture_chunk_typ) >> 2));
+    }
+
+    // Chunks are word aligned and inside the data, checked before anything is swapped in them
+    for (i = 0; i < header->chunk_count; i++)
+    {
+        if ((table[i].offset & 3) || table[i].offset > header->data_size || 
+            table[i].size > header->data_size - table[i].offset)
+        {
+            return(NULL);
+        }
+    }
+
+    if (swapped)
+    {
+        // Source pixels are bytes, only PLUT entries need swapping
+        for (i = 0; i < header->chunk_count; i++)
+        {
+            if (table[i].kind != CAPTURE_CHUNK_PLUT)
+                continue;
+
+            plut = (uint16*) (source + table[i].offset);
+
+            for (j = 0; j < table[i].size >> 1; j++)
+                plut[j] = SWAP16(plut[j]);
+        }
+    }
+
+    for (i = 0; i < header->ccb_count; i++)
+    {
+        rec = &records[i];
+        ccb = &ccbs[i];
+
+        // Links only run forward so the chain always ends, layer indexes the cost report
+        if ((rec->next != CAPTURE_NONE && (rec->next <= i || rec->next >= header->ccb_count)) || 
+            rec->layer >= DLIST_MAX_LAYERS)
+        {
+            return(NULL);
+        }
+
+        // Pointers must start a chunk of their kind, big enough for what the CEL reads
+        chunk = NULL;
+
+        if (rec->plut != CAPTURE_NONE)
+        {
+            chunk = find_loaded_chunk(table, header->chunk_count, rec->plut, CAPTURE_CHUNK_PLUT);
+
+            if (!chunk || chunk->size < 32 * sizeof(uint16))
+                return(NULL);
+        }
+
+        if (rec->source != CAPTURE_NONE)
+        {
+            chunk = find_loaded_chunk(table, header->chunk_count, rec->source, CAPTURE_CHUNK_SOURCE);
+
+            if (!chunk)
+                return(NULL);
+        }
+
+        ccb->ccb_Flags = rec->flags | CCB_NPABS | CCB_SPABS | CCB_PPABS;
+        ccb->ccb_NextPtr = (rec->next == CAPTURE_NONE) ? NULL : &ccbs[rec->next];
+        ccb->ccb_SourcePtr = (CelData*) ((rec->source == CAPTURE_NONE) ? NULL : source + rec->source);
+        ccb->ccb_PLUTPtr = (rec->plut == CAPTURE_NONE) ? NULL : (void*) (source + rec->plut);
+        ccb->ccb_XPos = rec->x_pos;
+        ccb->ccb_YPos = rec->y_pos;
+        ccb->ccb_HDX = rec->hdx;
+        ccb->ccb_HDY = rec->hdy;
+        ccb->ccb_VDX = rec->vdx;
+        ccb->ccb_VDY = rec->vdy;
+        ccb->ccb_HDDX = rec->hddx;
+        ccb->ccb_HDDY = rec->hddy;
+        ccb->ccb_PIXC = rec->pixc;
+        ccb->ccb_PRE0 = rec->pre0;
+        ccb->ccb_PRE1 = rec->pre1;
+        ccb->ccb_Width = rec->width;
+        ccb->ccb_Height = rec->height;
+
+        if (rec->source != CAPTURE_NONE && get_source_size(ccb, chunk->size) == CAPTURE_NONE)
+            return(NULL);
+
+        if (layers)
+            layers[i] = rec->layer;
+    }
+
+    LAST_CEL((&ccbs[header->ccb_count - 1]));
+
+    return(&ccbs[0]);
+}
+
+#ifdef SOFTCEL
+
+int32 capture_read(char *file_path, void *data, uint32 max_size)
+{
+    FILE *fin;
+    int32 size;
+
+    fin = fopen(file_path, "rb");
+
+    if (!fin)
+        return(-1);
+
+    size = (int32) fread(data, 1, max_size, fin);
+    fclose(fin);
+
+    return(size);
+}
+
+int32 capture_replay(void *data, uint32 size, softcel_target_typ_ptr target, celcost_report_typ_ptr report)
+{
+    static CCB ccbs[CAPTURE_MAX_CCBS];
+    static uint32 layers[CAPTURE_MAX_CCBS];
+    uint32 i, count, first;
+    CCB *ccb;
+
+    ccb = capture_load(data, size, ccbs, CAPTURE_MAX_CCBS, layers);
+
+    if (!ccb)
+        return(-1);
+
+    count = ((capture_header_typ_ptr) data)->ccb_count;
+
+    softcel_draw(target, ccb);
+
+    if (report)
+    {
+        // One chain per run of CCBs from the same layer
+        for (i = 0, first = 0; i < count; i++)
+        {
+            if (i + 1 == count || layers[i + 1] != layers[first])
+            {
+                celcost_add_chain(report, layers[first], &ccbs[first], &ccbs[i]);
+                first = i + 1;
+            }
+        }
+    }
+
+    return((int32) count);
+}
+
+#endif // SOFTCEL
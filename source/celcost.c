@@ -0,0 +1,292 @@
+#include "celcost.h"
+#include "cel_helper.h"
+
+// 3DO includes
+#include "stdio.h"
+#include "string.h"
+
+#define CLIP_MAX_CORNERS 8  // A quad cut by four edges
+#define COORD_LIMIT 16384   // Corners are clamped here so products fit 32 bits
+
+typedef struct corner_typ
+{
+    int32 x;
+    int32 y;
+} corner_typ;
+
+static const char *group_names[CELCOST_MAX_GROUPS] = {"BG", "3D", "HUD", "OVERLAY"};
+
+/* *************************************************************************************** */
+/* ========================== PRIVATE FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+static int32 clamp_coord(int32 v)
+{
+    v >>= FRACBITS_16;
+
+    if (v < -COORD_LIMIT) return(-COORD_LIMIT);
+    if (v > COORD_LIMIT) return(COORD_LIMIT);
+
+    return(v);
+}
+
+// Source size from the preamble, packed cels only have the CCB size
+static void get_cel_size(CCB *ccb, int32 *width, int32 *height)
+{
+    if (ccb->ccb_Flags & CCB_PACKED)
+    {
+        *width = ccb->ccb_Width;
+        *height = ccb->ccb_Height;
+        return;
+    }
+
+    *width = GET_CEL_TLHPCNT(ccb) + PRE1_TLHPCNT_PREFETCH - GET_CEL_SKIPX(ccb);
+    *height = GET_CEL_VCNT(ccb) + PRE0_VCNT_PREFETCH;
+}
+
+// Screen outline in whole pixels. HDX and friends are 12.20, positions 16.16.
+static void get_cel_outline(CCB *ccb, int32 width, int32 height, corner_typ *corners)
+{
+    int32 bottom_x, bottom_y;
+    int32 bottom_hdx, bottom_hdy;
+
+    bottom_x = ccb->ccb_XPos + height * ccb->ccb_VDX;
+    bottom_y = ccb->ccb_YPos + height * ccb->ccb_VDY;
+    bottom_hdx = ccb->ccb_HDX + height * ccb->ccb_HDDX;
+    bottom_hdy = ccb->ccb_HDY + height * ccb->ccb_HDDY;
+
+    corners[0].x = clamp_coord(ccb->ccb_XPos);
+    corners[0].y = clamp_coord(ccb->ccb_YPos);
+    corners[1].x = clamp_coord(ccb->ccb_XPos + width * (ccb->ccb_HDX >> 4));
+    corners[1].y = clamp_coord(ccb->ccb_YPos + width * (ccb->ccb_HDY >> 4));
+    corners[2].x = clamp_coord(bottom_x + width * (bottom_hdx >> 4));
+    corners[2].y = clamp_coord(bottom_y + width * (bottom_hdy >> 4));
+    corners[3].x = clamp_coord(bottom_x);
+    corners[3].y = clamp_coord(bottom_y);
+}
+
+// One Sutherland-Hodgman pass, keeps coord >= limit or coord <= limit
+static uint32 clip_edge(corner_typ *in, uint32 n, corner_typ *out, Boolean use_y, Boolean keep_greater, int32 limit)
+{
+    uint32 i, count;
+    int32 ca, cb;
+    Boolean a_in, b_in;
+    corner_typ *a, *b;
+
+    for (i = 0, count = 0; i < n; i++)
+    {
+        a = &in[i];
+        b = &in[(i + 1 == n) ? 0 : i + 1];
+        ca = use_y ? a->y : a->x;
+        cb = use_y ? b->y : b->x;
+        a_in = keep_greater ? (ca >= limit) : (ca <= limit);
+        b_in = keep_greater ? (cb >= limit) : (cb <= limit);
+
+        if (a_in)
+            out[count++] = *a;
+
+        if (a_in != b_in)
+        {
+            if (use_y)
+            {
+                out[count].x = a->x + (b->x - a->x) * (limit - ca) / (cb - ca);
+                out[count].y = limit;
+            }
+            else 
+            {
+                out[count].x = limit;
+                out[count].y = a->y + (b->y - a->y) * (limit - ca) / (cb - ca);
+            }
+
+            count++;
+        }
+    }
+
+    return(count);
+}
+
+static uint32 clip_to_screen(corner_typ *corners, uint32 n)
+{
+    corner_typ temp[CLIP_MAX_CORNERS];
+
+    n = clip_edge(corners, n, temp, FALSE, TRUE, 0);
+    n = clip_edge(temp, n, corners, FALSE, FALSE, CELCOST_SCREEN_W);
+    n = clip_edge(corners, n, temp, TRUE, TRUE, 0);
+    n = clip_edge(temp, n, corners, TRUE, FALSE, CELCOST_SCREEN_H);
+
+    return(n);
+}
+
+// Shoelace area of the clipped outline
+static uint32 outline_area(corner_typ *corners, uint32 n)
+{
+    uint32 i;
+    int32 area = 0;
+
+    for (i = 0; i < n; i++)
+        area += corners[i].x * corners[(i + 1 == n) ? 0 : i + 1].y - corners[(i + 1 == n) ? 0 : i + 1].x * corners[i].y;
+
+    if (area < 0)
+        area = -area;
+
+    return((uint32) (area >> 1));
+}
+
+static void mark_heatmap(celcost_report_typ_ptr report, corner_typ *corners, uint32 n)
+{
+    uint32 i;
+    int32 tx, ty;
+    int32 min_x, max_x, min_y, max_y;
+
+    min_x = max_x = corners[0].x;
+    min_y = max_y = corners[0].y;
+
+    for (i = 1; i < n; i++)
+    {
+        if (corners[i].x < min_x) min_x = corners[i].x;
+        if (corners[i].x > max_x) max_x = corners[i].x;
+        if (corners[i].y < min_y) min_y = corners[i].y;
+        if (corners[i].y > max_y) max_y = corners[i].y;
+    }
+
+    // Outline is already on screen, the far edge is exclusive
+    min_x >>= CELCOST_TILE_SHIFT;
+    min_y >>= CELCOST_TILE_SHIFT;
+    max_x = (max_x - 1) >> CELCOST_TILE_SHIFT;
+    max_y = (max_y - 1) >> CELCOST_TILE_SHIFT;
+
+    for (ty = min_y; ty <= max_y; ty++)
+    {
+        for (tx = min_x; tx <= max_x; tx++)
+        {
+            if (report->heatmap[ty][tx] < 255)
+                report->heatmap[ty][tx]++;
+        }
+    }
+}
+
+static void add_group(celcost_group_typ_ptr dest, celcost_group_typ_ptr source)
+{
+    dest->cels += source->cels;
+    dest->skipped += source->skipped;
+    dest->offscreen += source->offscreen;
+    dest->plut_loads += source->plut_loads;
+    dest->source_pixels += source->source_pixels;
+    dest->screen_pixels += source->screen_pixels;
+}
+
+/* *************************************************************************************** */
+/* =========================== PUBLIC FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+void celcost_reset(celcost_report_typ_ptr report)
+{
+    memset((void*)report, 0, sizeof(celcost_report_typ));
+}
+
+void celcost_add_chain(celcost_report_typ_ptr report, uint32 group, CCB *first, CCB *last)
+{
+    int32 width, height;
+    uint32 n, pixels;
+    corner_typ corners[CLIP_MAX_CORNERS];
+    celcost_group_typ chain;
+    CCB *ccb = first;
+
+    #if DEBUG_MODE 
+        if (group >= CELCOST_MAX_GROUPS)
+            printf("Error - Invalid cel cost group %d.\n", group);
+    #endif 
+
+    memset((void*)&chain, 0, sizeof(celcost_group_typ));
+
+    while (ccb)
+    {
+        if (ccb->ccb_Flags & CCB_SKIP)
+        {
+            chain.skipped++;
+        }
+        else 
+        {
+            chain.cels++;
+
+            if (ccb->ccb_Flags & CCB_LDPLUT)
+                chain.plut_loads++;
+
+            get_cel_size(ccb, &width, &height);
+            chain.source_pixels += width * height;
+
+            get_cel_outline(ccb, width, height, corners);
+            n = clip_to_screen(corners, 4);
+            pixels = (n >= 3) ? outline_area(corners, n) : 0;
+
+            if (pixels == 0)
+            {
+                chain.offscreen++;
+            }
+            else 
+            {
+                chain.screen_pixels += pixels;
+                mark_heatmap(report, corners, n);
+
+                if (pixels > report->worst_pixels)
+                {
+                    report->worst_ccb = ccb;
+                    report->worst_pixels = pixels;
+                    report->worst_group = group;
+                }
+            }
+        }
+
+        if (ccb == last || (ccb->ccb_Flags & CCB_LAST))
+            break;
+
+        ccb = ccb->ccb_NextPtr;
+    }
+
+    add_group(&report->groups[group], &chain);
+    add_group(&report->total, &chain);
+}
+
+void celcost_print(celcost_report_typ_ptr report, char *label)
+{
+    uint32 i, tx, ty;
+    uint32 count;
+    celcost_group_typ_ptr g;
+    char row[CELCOST_TILES_X + 1];
+
+    printf("-----------------------------------------------\n");
+    printf("CEL cost %s\n", label);
+    printf("GROUP    CELS SKIP  OFF PLUT   SOURCE   SCREEN\n");
+
+    for (i = 0; i <= CELCOST_MAX_GROUPS; i++)
+    {
+        g = (i < CELCOST_MAX_GROUPS) ? &report->groups[i] : &report->total;
+
+        printf("%-8s %4d %4d %4d %4d %8d %8d\n", (i < CELCOST_MAX_GROUPS) ? group_names[i] : "TOTAL", 
+            g->cels, g->skipped, g->offscreen, g->plut_loads, g->source_pixels, g->screen_pixels);
+    }
+
+    // Percent of the screen written, 100 means every pixel once
+    printf("Overdraw %d%%\n", (report->total.screen_pixels * 100) / (CELCOST_SCREEN_W * CELCOST_SCREEN_H));
+
+    if (report->worst_ccb)
+    {
+        printf("Worst cel %p in %s, %d pixels, HDX %d VDY %d\n", (void*) report->worst_ccb, group_names[report->worst_group], 
+            report->worst_pixels, report->worst_ccb->ccb_HDX, report->worst_ccb->ccb_VDY);
+    }
+
+    // One character per tile, . for none, 1 - 9, then + for ten or more
+    for (ty = 0; ty < CELCOST_TILES_Y; ty++)
+    {
+        for (tx = 0; tx < CELCOST_TILES_X; tx++)
+        {
+            count = report->heatmap[ty][tx];
+            row[tx] = (count == 0) ? '.' : ((count > 9) ? '+' : (char) ('0' + count));
+        }
+
+        row[CELCOST_TILES_X] = 0;
+        printf("%s\n", row);
+    }
+
+    printf("-----------------------------------------------\n");
+}
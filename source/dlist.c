@@ -0,0 +1,98 @@
+#include "dlist.h"
+#include "cel_helper.h"
+
+// 3DO includes
+#include "stdio.h"
+#include "string.h"
+#include "celutils.h"
+
+/* *************************************************************************************** */
+/* ==================================== PRIVATE VARS ===================================== */
+/* *************************************************************************************** */
+
+static dlist_layer_typ layers[DLIST_MAX_LAYERS];
+
+/* *************************************************************************************** */
+/* =========================== PUBLIC FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+void dlist_reset(void)
+{
+    memset((void*)layers, 0, sizeof(dlist_layer_typ) * DLIST_MAX_LAYERS);
+}
+
+void dlist_set_layer(uint32 layer, CCB *first, CCB *last)
+{
+    #if DEBUG_MODE 
+        if (layer >= DLIST_MAX_LAYERS)
+            printf("Error - Invalid display list layer %d.\n", layer);
+    #endif 
+
+    layers[layer].first = first;
+    layers[layer].last = (first) ? last : NULL;
+}
+
+void dlist_append(uint32 layer, CCB *first, CCB *last)
+{
+    dlist_layer_typ_ptr lptr = &layers[layer];
+
+    if (lptr->first)
+    {
+        UNLAST_CEL(lptr->last);
+        LINK_CEL(lptr->last, first);
+    }
+    else 
+    {
+        lptr->first = first;
+    }
+
+    lptr->last = last;
+}
+
+void dlist_show_layer(uint32 layer, Boolean show)
+{
+    layers[layer].hidden = !show;
+}
+
+dlist_layer_typ_ptr dlist_get_layer(uint32 layer)
+{
+    return(&layers[layer]);
+}
+
+CCB *dlist_link(void)
+{
+    uint32 i;
+    CCB *first = NULL;
+    CCB *last = NULL;
+
+    for (i = 0; i < DLIST_MAX_LAYERS; i++)
+    {
+        if (layers[i].hidden || !layers[i].first)
+            continue;
+
+        if (last)
+        {
+            UNLAST_CEL(last);
+            LINK_CEL(last, layers[i].first);
+        }
+        else 
+        {
+            first = layers[i].first;
+        }
+
+        last = layers[i].last;
+    }
+
+    if (last)
+        LAST_CEL(last);
+
+    return(first);
+}
+
+void dlist_draw(Item bitmap_item)
+{
+    CCB *first = dlist_link();
+
+    if (first)
+        DrawCels(bitmap_item, first);
+}
@@ -0,0 +1,153 @@
+#include "fixmath.h"
+
+#ifdef FIXMATH_PORTABLE
+
+#define ONE_F16 65536
+
+// Arithmetic shift of the 64 bit product, straight line code so the kernels vectorize
+#define MUL_F16(a, b) ((frac16) (((int64_t) (a) * (b)) >> 16))
+
+/* *************************************************************************************** */
+/* =========================== PUBLIC FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+frac16 fix_mul_f16(frac16 a, frac16 b)
+{
+    return(MUL_F16(a, b));
+}
+
+frac16 fix_div_f16(frac16 a, frac16 b)
+{
+    if (b == 0)
+        return((a < 0) ? (frac16) INT32_MIN : INT32_MAX);
+
+    // C99 division truncates toward zero
+    return((frac16) (((int64_t) a * ONE_F16) / b));
+}
+
+frac16 fix_sqrt_f16(frac16 a)
+{
+    uint32 remainder, root, bit;
+    int32 i;
+
+    if (a <= 0)
+        return(0);
+
+    // sqrt(a << 16), two bits of input per result bit
+    remainder = 0;
+    root = 0;
+
+    for (i = 0; i < 24; i++)
+    {
+        remainder = (remainder << 2) | (i < 16 ? (((uint32) a >> (30 - (i << 1))) & 3) : 0);
+        root <<= 1;
+        bit = (root << 1) | 1;
+
+        if (remainder >= bit)
+        {
+            remainder -= bit;
+            root |= 1;
+        }
+    }
+
+    return((frac16) root);
+}
+
+frac16 fix_dot3_f16(vec3f16 a, vec3f16 b)
+{
+    return(MUL_F16(a[0], b[0]) + MUL_F16(a[1], b[1]) + MUL_F16(a[2], b[2]));
+}
+
+void fix_cross3_f16(vec3f16 dest, vec3f16 a, vec3f16 b)
+{
+    vec3f16 temp;
+
+    temp[0] = MUL_F16(a[1], b[2]) - MUL_F16(a[2], b[1]);
+    temp[1] = MUL_F16(a[2], b[0]) - MUL_F16(a[0], b[2]);
+    temp[2] = MUL_F16(a[0], b[1]) - MUL_F16(a[1], b[0]);
+
+    dest[0] = temp[0];
+    dest[1] = temp[1];
+    dest[2] = temp[2];
+}
+
+void fix_mul_vec3_mat33_f16(vec3f16 dest, vec3f16 vec, mat33f16 mat)
+{
+    frac16 x, y, z;
+
+    x = vec[0];
+    y = vec[1];
+    z = vec[2];
+
+    dest[0] = MUL_F16(x, mat[0][0]) + MUL_F16(y, mat[1][0]) + MUL_F16(z, mat[2][0]);
+    dest[1] = MUL_F16(x, mat[0][1]) + MUL_F16(y, mat[1][1]) + MUL_F16(z, mat[2][1]);
+    dest[2] = MUL_F16(x, mat[0][2]) + MUL_F16(y, mat[1][2]) + MUL_F16(z, mat[2][2]);
+}
+
+void fix_mul_many_vec3_mat33_f16(vec3f16 *dest, vec3f16 *src, mat33f16 mat, int32 count)
+{
+    frac16 m00, m01, m02, m10, m11, m12, m20, m21, m22;
+    frac16 x, y, z;
+
+    // Matrix kept in locals so the loop body has no loads that could alias dest
+    m00 = mat[0][0]; m01 = mat[0][1]; m02 = mat[0][2];
+    m10 = mat[1][0]; m11 = mat[1][1]; m12 = mat[1][2];
+    m20 = mat[2][0]; m21 = mat[2][1]; m22 = mat[2][2];
+
+    while (count-- > 0)
+    {
+        x = (*src)[0];
+        y = (*src)[1];
+        z = (*src)[2];
+
+        (*dest)[0] = MUL_F16(x, m00) + MUL_F16(y, m10) + MUL_F16(z, m20);
+        (*dest)[1] = MUL_F16(x, m01) + MUL_F16(y, m11) + MUL_F16(z, m21);
+        (*dest)[2] = MUL_F16(x, m02) + MUL_F16(y, m12) + MUL_F16(z, m22);
+
+        src++;
+        dest++;
+    }
+}
+
+void fix_mul_mat33_mat33_f16(mat33f16 dest, mat33f16 a, mat33f16 b)
+{
+    mat33f16 temp;
+    int32 i, j;
+
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < 3; j++)
+            temp[i][j] = MUL_F16(a[i][0], b[0][j]) + MUL_F16(a[i][1], b[1][j]) + MUL_F16(a[i][2], b[2][j]);
+    }
+
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < 3; j++)
+            dest[i][j] = temp[i][j];
+    }
+}
+
+#endif // FIXMATH_PORTABLE
+
+void fix_project_points_f16(Point *dest, vec3f16 *src, int32 count, int32 view_shift, int32 near, 
+    frac16 center_x, frac16 center_y)
+{
+    int32 z;
+
+    while (count-- > 0)
+    {
+        z = (*src)[2];
+
+        if (z < near) 
+            z = near;
+
+        if (z == 0) 
+            z = 1;
+
+        dest->pt_X = FIX_DIV((*src)[0] << view_shift, z) + center_x;
+        dest->pt_Y = FIX_DIV(-(*src)[1] << view_shift, z) + center_y;
+
+        src++;
+        dest++;
+    }
+}
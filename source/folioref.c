@@ -0,0 +1,125 @@
+#include "folioref.h"
+
+#ifndef FIXMATH_PORTABLE
+    #include "stdio.h"
+#endif
+
+/* *************************************************************************************** */
+/* ================================ CONSTANTS / TYPES ==================================== */
+/* *************************************************************************************** */
+
+#define EDGE_COUNT 12
+
+/* *************************************************************************************** */
+/* ================================== PRIVATE VARS ======================================= */
+/* *************************************************************************************** */
+
+// Values where rounding and overflow differ between implementations
+static frac16 edge_values[EDGE_COUNT] = 
+{
+    0, 1, -1, 0x8000, -0x8000, 0x10000, -0x10000, 0x18000, 
+    0x7FFFFFFF, -0x7FFFFFFF, 0x00FFFFFF, -0x00FFFFFF
+};
+
+/* *************************************************************************************** */
+/* ========================== PRIVATE FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+// Fixed LCG so every build sees the same sequence
+static uint32 next_random(uint32 seed)
+{
+    return(seed * 1664525 + 1013904223);
+}
+
+// Spread values over the useful range of each kind
+static frac16 scale_input(uint32 kind, uint32 r)
+{
+    switch(kind)
+    {
+    case FOLIOREF_MUL:
+        return((frac16) r >> (r & 15));         // Mixed magnitudes, some overflow
+    case FOLIOREF_DIV:
+        return((frac16) r >> (8 + (r & 15)));
+    case FOLIOREF_SQRT:
+        return((frac16) (r >> 1));
+    case FOLIOREF_SIN:
+    case FOLIOREF_COS:
+        return((frac16) r >> 6);                // A few turns either way
+    default:
+        return((frac16) r >> (4 + (r & 15)));
+    }
+}
+
+/* *************************************************************************************** */
+/* =========================== PUBLIC FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+void folioref_input(uint32 kind, uint32 index, frac16 *a, frac16 *b)
+{
+    uint32 seed;
+
+    if (index < EDGE_COUNT * EDGE_COUNT)
+    {
+        *a = edge_values[index % EDGE_COUNT];
+        *b = edge_values[index / EDGE_COUNT];
+    }
+    else
+    {
+        seed = next_random(index * 2 + kind * 7919);
+        *a = scale_input(kind, seed);
+        seed = next_random(seed);
+        *b = scale_input(kind, seed);
+    }
+
+    if (kind == FOLIOREF_SQRT && *a < 0)
+        *a = -(*a + 1);
+
+    if (kind == FOLIOREF_SQRT || kind == FOLIOREF_SIN || kind == FOLIOREF_COS)
+        *b = 0;
+}
+
+#ifndef FIXMATH_PORTABLE
+
+void folioref_dump(void)
+{
+    uint32 kind;
+    uint32 i;
+    frac16 a;
+    frac16 b;
+    frac16 result;
+
+    for (kind = 0; kind < FOLIOREF_KINDS; kind++)
+    {
+        for (i = 0; i < FOLIOREF_COUNT; i++)
+        {
+            folioref_input(kind, i, &a, &b);
+
+            switch(kind)
+            {
+            case FOLIOREF_MUL:
+                result = MulSF16(a, b);
+                break;
+            case FOLIOREF_DIV:
+                result = (b == 0) ? 0 : DivSF16(a, b);
+                break;
+            case FOLIOREF_SQRT:
+                result = SqrtF16(a);
+                break;
+            case FOLIOREF_SIN:
+                result = SinF16(a);
+                break;
+            case FOLIOREF_COS:
+                result = CosF16(a);
+                break;
+            default:
+                result = Atan2F16(a, b);
+                break;
+            }
+
+            printf("FREF %d %d %08x %08x %08x\n", (int) kind, (int) i, (unsigned int) a, 
+                (unsigned int) b, (unsigned int) result);
+        }
+    }
+}
+
+#endif // FIXMATH_PORTABLE
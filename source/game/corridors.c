@@ -1,8 +1,66 @@
 #include "game_globals.h"
 
-poly_props_typ get_corridor_props(polygon_typ_ptr corridor)
+#define SLOT_NONE 0xFFFF
+
+/* *************************************************************************************** */
+/* =================================== PRIVATE VARS ====================================== */
+/* *************************************************************************************** */
+
+/*  Occupancy index. Each corridor keeps a list of the enemies on it, nearest Z first, 
+    linked by slot in enemies[]. Only one spike can grow on a corridor. */
+
+static uint16 enemy_heads[MAX_LEVEL_POLYS];
+static uint16 enemy_links[MAX_ENEMIES];
+static uint16 enemy_corridors[MAX_ENEMIES];     // Corridor each slot is listed on, or SLOT_NONE
+static spike_typ_ptr corridor_spikes[MAX_LEVEL_POLYS];
+static enemy_typ_ptr rim_enemies[MAX_ENEMIES];  // Flippers and fuseballs on the near rim
+static uint32 rim_count;
+
+// One bit per corridor, set while it has an enemy or a spike. MAX_LEVEL_POLYS must fit.
+static uint32 enemy_bits;
+static uint32 spike_bits;
+
+/* *************************************************************************************** */
+/* ========================== PRIVATE FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+static void link_enemy(uint32 slot, uint32 corridor_index)
+{
+    uint16 *link = &enemy_heads[corridor_index];
+    int32 z = enemies[slot].obj->world_z;
+
+    // Keep nearest first
+    while (*link != SLOT_NONE && enemies[*link].obj->world_z < z)
+        link = &enemy_links[*link];
+
+    enemy_links[slot] = *link;
+    *link = (uint16) slot;
+    enemy_corridors[slot] = (uint16) corridor_index;
+    enemy_bits |= 1 << corridor_index;
+}
+
+static void unlink_enemy(uint32 slot)
+{
+    uint16 *link;
+
+    if (enemy_corridors[slot] == SLOT_NONE)
+        return;
+
+    link = &enemy_heads[enemy_corridors[slot]];
+
+    while (*link != slot)
+        link = &enemy_links[*link];
+
+    *link = enemy_links[slot];
+
+    if (enemy_heads[enemy_corridors[slot]] == SLOT_NONE)
+        enemy_bits &= ~(1 << enemy_corridors[slot]);
+
+    enemy_corridors[slot] = SLOT_NONE;
+}
+
+static void calc_corridor_edge(corridor_typ_ptr entry, polygon_typ_ptr corridor)
 {
-    poly_props_typ props;
     vertex_typ_ptr verts;
     uint32 i, j;
     uint32 edge_lut[2];
@@ -22,66 +80,84 @@ poly_props_typ get_corridor_props(polygon_typ_ptr corridor)
     #endif 
 
     // Point 1
-    props.near_edge[0][VERTEX_X] = verts[edge_lut[0]].vertex[VERTEX_X];
-    props.near_edge[0][VERTEX_Y] = verts[edge_lut[0]].vertex[VERTEX_Y];
-    props.near_edge[0][VERTEX_Z] = verts[edge_lut[0]].vertex[VERTEX_Z];
+    entry->near_edge[0][VERTEX_X] = verts[edge_lut[0]].vertex[VERTEX_X];
+    entry->near_edge[0][VERTEX_Y] = verts[edge_lut[0]].vertex[VERTEX_Y];
+    entry->near_edge[0][VERTEX_Z] = verts[edge_lut[0]].vertex[VERTEX_Z];
 
     // Point 2
-    props.near_edge[2][VERTEX_X] = verts[edge_lut[1]].vertex[VERTEX_X];
-    props.near_edge[2][VERTEX_Y] = verts[edge_lut[1]].vertex[VERTEX_Y];
-    props.near_edge[2][VERTEX_Z] = verts[edge_lut[1]].vertex[VERTEX_Z];
+    entry->near_edge[2][VERTEX_X] = verts[edge_lut[1]].vertex[VERTEX_X];
+    entry->near_edge[2][VERTEX_Y] = verts[edge_lut[1]].vertex[VERTEX_Y];
+    entry->near_edge[2][VERTEX_Z] = verts[edge_lut[1]].vertex[VERTEX_Z];
 
     // Median
-    props.near_edge[1][VERTEX_X] = (props.near_edge[0][VERTEX_X] + props.near_edge[2][VERTEX_X]) >> 1;
-    props.near_edge[1][VERTEX_Y] = (props.near_edge[0][VERTEX_Y] + props.near_edge[2][VERTEX_Y]) >> 1;
-    props.near_edge[1][VERTEX_Z] = (props.near_edge[0][VERTEX_Z] + props.near_edge[2][VERTEX_Z]) >> 1;
-
-    return(props);
+    entry->near_edge[1][VERTEX_X] = (entry->near_edge[0][VERTEX_X] + entry->near_edge[2][VERTEX_X]) >> 1;
+    entry->near_edge[1][VERTEX_Y] = (entry->near_edge[0][VERTEX_Y] + entry->near_edge[2][VERTEX_Y]) >> 1;
+    entry->near_edge[1][VERTEX_Z] = (entry->near_edge[0][VERTEX_Z] + entry->near_edge[2][VERTEX_Z]) >> 1;
 }
 
-void snap_obj_to_corridor(object_typ_ptr obj, polygon_typ_ptr corridor, int32 z)
+// Requires the near edge and the polygon normal
+static void calc_corridor_angle(corridor_typ_ptr entry, polygon_typ_ptr corridor)
 {
-    vec3f16 rot_angles;
-    poly_props_typ props = get_corridor_props(corridor);
+    int32 delta_x, delta_y;
 
-    // Set position
-    obj->world_x = props.near_edge[1][VERTEX_X]; // Median
-    obj->world_y = props.near_edge[1][VERTEX_Y];
-    obj->world_z = z;
+    delta_x = entry->near_edge[1][VERTEX_X] - entry->near_edge[0][VERTEX_X];
+    delta_y = entry->near_edge[1][VERTEX_Y] - entry->near_edge[0][VERTEX_Y];
+
+    // Avoid divide by zero. Is plane parallel to X axis?
+    if (delta_y == 0)
+        entry->angle = (corridor->normal[1] > 0) ? 0 : 8388608;        
+    else 
+        entry->angle = atan2_f16(delta_x, delta_y);
+
+    sincos_f16(entry->angle, &entry->sin_angle, &entry->cos_angle);
+}
+
+/* *************************************************************************************** */
+/* =========================== PUBLIC FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
 
-    // Set rotation
-    
-    copy_vertex_def(&obj->vertex_def, &obj->vertex_def_copy); // Reset verts first
+void init_corridors(level_typ_ptr level)
+{
+    uint32 i;
+    uint32 count;
+    corridor_typ_ptr entry;
 
-    rot_angles[ANGLE_Z] = get_corridor_angle(corridor);
+    count = level->obj->poly_count;
+    entry = level->corridors;
 
-    if (rot_angles[ANGLE_Z] != 0)
+    for (i = 0; i < count; i++)
     {
-        rot_angles[ANGLE_X] = 0;
-        rot_angles[ANGLE_Y] = 0;
-        rot_angles[ANGLE_Z] = -rot_angles[ANGLE_Z];
-        rotate_obj(obj, rot_angles);
+        calc_corridor_edge(entry, &level->obj->polygons[i]);
+        calc_corridor_angle(entry, &level->obj->polygons[i]);
+
+        // Index order runs left to right, wrapping levels join both ends
+        entry->left = (i > 0) ? (int32) i - 1 : (level->wrap ? (int32) count - 1 : -1);
+        entry->right = (i + 1 < count) ? (int32) i + 1 : (level->wrap ? 0 : -1);
+
+        ++entry;
     }
 }
 
-int32 get_corridor_angle(polygon_typ_ptr corridor)
+corridor_typ_ptr get_corridor(uint32 corridor_index)
 {
-    int32 delta_x, delta_y;
-    int32 angle;
-    poly_props_typ props;
+    return(&LCONTEXT_LEVEL.corridors[corridor_index]);
+}
 
-    props = get_corridor_props(corridor);
+void snap_obj_to_corridor(object_typ_ptr obj, uint32 corridor_index, int32 z)
+{
+    corridor_typ_ptr corridor = get_corridor(corridor_index);
 
-    delta_x = props.near_edge[1][VERTEX_X] - props.near_edge[0][VERTEX_X];
-    delta_y = props.near_edge[1][VERTEX_Y] - props.near_edge[0][VERTEX_Y];
+    // Set position
+    obj->world_x = corridor->near_edge[1][VERTEX_X]; // Median
+    obj->world_y = corridor->near_edge[1][VERTEX_Y];
+    obj->world_z = z;
 
-    // Avoid divide by zero. Is plane parallel to X axis?
-    if (delta_y == 0)
-        angle = (corridor->normal[1] > 0) ? 0 : 8388608;        
-    else 
-        angle = Atan2F16(delta_x, delta_y);
+    // Set rotation, opposite of the corridor angle
 
-    return(angle);
+    if (corridor->angle != 0)
+        set_obj_rotation_z(obj, -corridor->sin_angle, corridor->cos_angle);
+    else 
+        reset_obj_rotation(obj);
 }
 
 void reset_corridor(uint32 corridor_index)
@@ -107,4 +183,214 @@ void reset_corridor_palette(uint32 corridor_index)
 void set_corridor_color(uint32 corridor_index, uint16 color)
 {
     set_cel_pal_to_color(LCONTEXT_LEVEL.obj->polygons[corridor_index].ccb, color);
-}
\ No newline at end of file
+}
+
+void clear_corridor_enemies(void)
+{
+    uint32 i;
+
+    for (i = 0; i < MAX_LEVEL_POLYS; i++)
+        enemy_heads[i] = SLOT_NONE;
+
+    for (i = 0; i < MAX_ENEMIES; i++)
+        enemy_corridors[i] = SLOT_NONE;
+
+    rim_count = 0;
+    enemy_bits = 0;
+}
+
+void clear_corridor_spikes(void)
+{
+    memset((void*)corridor_spikes, 0, sizeof(spike_typ_ptr) * MAX_LEVEL_POLYS);
+    spike_bits = 0;
+}
+
+void index_enemy(enemy_typ_ptr enemy)
+{
+    uint32 slot = enemy - enemies;
+
+    if (enemy_corridors[slot] == enemy->corridor_index)
+        return;
+
+    unlink_enemy(slot);
+    link_enemy(slot, enemy->corridor_index);
+}
+
+void unindex_enemy(enemy_typ_ptr enemy)
+{
+    unlink_enemy(enemy - enemies);
+}
+
+void index_spike(spike_typ_ptr spike)
+{
+    #if DEBUG_MODE
+        if (corridor_spikes[spike->corridor_index])
+            printf("Error - Corridor %d already has a spike.\n", spike->corridor_index);
+    #endif
+
+    corridor_spikes[spike->corridor_index] = spike;
+    spike_bits |= 1 << spike->corridor_index;
+}
+
+void unindex_spike(spike_typ_ptr spike)
+{
+    if (corridor_spikes[spike->corridor_index] == spike)
+    {
+        corridor_spikes[spike->corridor_index] = NULL;
+        spike_bits &= ~(1 << spike->corridor_index);
+    }
+}
+
+void sort_corridor_enemies(void)
+{
+    uint32 i;
+    uint16 slot, next, tail;
+    uint16 *link;
+    int32 z;
+
+    rim_count = 0;
+
+    for (i = 0; i < LCONTEXT_LEVEL.obj->poly_count; i++)
+    {
+        /*  Insertion sort. Enemies rarely pass each other on a corridor, so lists are
+            nearly sorted and most enemies go straight onto the tail. */
+
+        slot = enemy_heads[i];
+        enemy_heads[i] = SLOT_NONE;
+        tail = SLOT_NONE;
+
+        while (slot != SLOT_NONE)
+        {
+            next = enemy_links[slot];
+            z = enemies[slot].obj->world_z;
+
+            if (tail == SLOT_NONE || enemies[tail].obj->world_z <= z)
+            {
+                link = (tail == SLOT_NONE) ? &enemy_heads[i] : &enemy_links[tail];
+                tail = slot;
+            }
+            else 
+            {
+                link = &enemy_heads[i];
+
+                while (enemies[*link].obj->world_z <= z)
+                    link = &enemy_links[*link];
+            }
+
+            enemy_links[slot] = *link;
+            *link = slot;
+
+            if (enemies[slot].state == ES_ACTIVE && IS_RIM_ENEMY(&enemies[slot]))
+                rim_enemies[rim_count++] = &enemies[slot];
+
+            slot = next;
+        }
+    }
+}
+
+enemy_typ_ptr get_corridor_enemy(uint32 corridor_index)
+{
+    uint16 slot = enemy_heads[corridor_index];
+
+    return((slot == SLOT_NONE) ? NULL : &enemies[slot]);
+}
+
+enemy_typ_ptr get_next_corridor_enemy(enemy_typ_ptr enemy)
+{
+    uint16 slot = enemy_links[enemy - enemies];
+
+    return((slot == SLOT_NONE) ? NULL : &enemies[slot]);
+}
+
+spike_typ_ptr get_corridor_spike(uint32 corridor_index)
+{
+    return(corridor_spikes[corridor_index]);
+}
+
+uint32 get_rim_enemies(enemy_typ_ptr **rim)
+{
+    *rim = rim_enemies;
+    return(rim_count);
+}
+
+enemy_typ_ptr get_bullet_enemy(bullet_typ_ptr bullet)
+{
+    uint32 i;
+    int32 delta_x, delta_y, dist;
+    int32 z = bullet->obj->world_z;
+    enemy_typ_ptr enemy;
+    corridor_typ_ptr corridor;
+    vec3f16 p1;
+
+    // Enemies on the near rim can be between corridors, so test them by distance
+    if (z <= (LEVEL_ZNEAR + 32768))
+    {
+        for (i = 0; i < rim_count; i++)
+        {
+            enemy = rim_enemies[i];
+
+            // A hit this frame may have already freed the slot
+            if (enemy->state != ES_ACTIVE || !IS_RIM_ENEMY(enemy))
+                continue;
+
+            delta_x = ABS_VALUE(enemy->obj->world_x - bullet->obj->world_x);
+            delta_y = ABS_VALUE(enemy->obj->world_y - bullet->obj->world_y);
+
+            if (delta_x < 12000 && delta_y < 12000)
+                return(enemy);
+        }
+    }
+
+    // Only enemies on the bullet's corridor can be hit, and they are listed nearest first
+    for (enemy = get_corridor_enemy(bullet->corridor_index); enemy; enemy = get_next_corridor_enemy(enemy))
+    {
+        // Everything after this is further away
+        if (z < enemy->obj->world_z - 16384)
+            break;
+
+        // Check bullet/enemy Z extents. Rim enemies count too, one rolling off this corridor is out of XY range.
+        if (enemy->state != ES_ACTIVE || z > enemy->obj->world_z + 16384)
+            continue;
+
+        if (enemy->enemy_type != FUSEBALL)
+            return(enemy);
+
+        // Only hit IF fuseball is not on corridor joint
+        corridor = get_corridor(enemy->corridor_index);
+
+        p1[X] = enemy->obj->world_x;
+        p1[Y] = enemy->obj->world_y;
+        p1[Z] = corridor->near_edge[1][Z];
+
+        dist = get_squared_dist(p1, corridor->near_edge[1]);
+
+        if (dist < 1000)
+            return(enemy);
+    }
+
+    return(NULL);
+}
+
+uint32 get_free_corridor(void)
+{
+    uint32 free, count, pick, index;
+
+    free = ~(enemy_bits | spike_bits) & ((1 << LCONTEXT_LEVEL.obj->poly_count) - 1);
+
+    if (!free)
+        return(CORRIDOR_NONE);
+
+    // Count free corridors, then drop the lowest set bit until the pick is lowest
+    for (count = 0, pick = free; pick; count++)
+        pick &= pick - 1;
+
+    pick = rand() % count;
+
+    while (pick-- > 0)
+        free &= free - 1;
+
+    for (index = 0; !(free & 1); index++)
+        free >>= 1;
+
+    return(index);
+}
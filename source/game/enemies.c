@@ -5,6 +5,7 @@
 #define ENEMY_BILLBOARD_S 42598
 #define MAX_ANIM_CYCLE 10
 #define PULSAR_COLOR 924
+#define ENEMY_ATLAS_FRAMES 21   // Enemy frames in type order, then the zapped frames
 
 /* *************************************************************************************** */
 /* ================================== PRIVATE TYPESS ===================================== */
@@ -17,11 +18,19 @@ struct
     uint32 active_enemies;
 } hostile_stats;
 
+typedef struct anim_frame_typ
+{
+    CelData *source;
+    void *plut;
+} anim_frame_typ, *anim_frame_typ_ptr;
+
 typedef struct cel_anim_typ 
 {
     uint32 frame_count;                     // Total frames in set
-    int32 frame_cycle_lut[MAX_ANIM_CYCLE];  // A value of -1 denotes the end
-    cel8_data_typ_ptr *frames;              // Pointer to frame array
+    anim_frame_typ_ptr frames;              // First of the set in atlas_frames
+    anim_frame_typ cycle[MAX_ANIM_CYCLE];   // Frames in play order, built at load
+    uint32 cycle_length;
+    void (*on_end)(enemy_typ_ptr);          // Called instead of looping when set
 } cel_anim_typ, *cel_anim_typ_ptr;
 
 /* *************************************************************************************** */
@@ -43,8 +52,18 @@ static cel_anim_typ enemy_anims[MAX_ENEMY_TYPES];
 static cel_anim_typ zapped_anim;
 static simple_timer_typ anim_timer;
 
-static char *enemy_names[MAX_ENEMY_TYPES] = {"Missile", "Flipper", 
-    "Tanker", "Spiker", "Fuseball", "Pulsar", "Ftanker", "Ptanker"};
+POOL_DEFINE(enemy_pool, MAX_ENEMIES);
+POOL_DEFINE(spike_pool, MAX_SPIKES);
+
+// Live slots of each type packed together, hostile_stats.enemy_counts is the length
+static uint16 type_slots[MAX_ENEMY_TYPES][MAX_ENEMIES];
+static uint16 type_positions[MAX_ENEMIES];
+
+/*  All enemy and zapped frames are 32x32 with the same layout. Their sources are packed 
+    end to end in one block, so picking a frame is only a source pointer. */
+static ubyte *atlas_source;
+static uint16 atlas_pluts[ENEMY_ATLAS_FRAMES][32];
+static anim_frame_typ atlas_frames[ENEMY_ATLAS_FRAMES];
 
 // Max simultaneous types
 static uint32 enemy_max_counts[MAX_ENEMY_TYPES] = {
@@ -82,6 +101,8 @@ static int32 frame_cycle_luts[MAX_ENEMY_TYPES][MAX_ANIM_CYCLE] = {
     {0, 1, 2, 1, -1, -1, -1, -1, -1, -1}    // PTANKER
 };
 
+static int32 zapped_cycle_lut[MAX_ANIM_CYCLE] = {2, 1, 0, 1, 2, -1, -1, -1, -1, -1};
+
 /* *************************************************************************************** */
 /* =========================== PRIVATE FUNCTION PROTOTYPES =============================== */
 /* *************************************************************************************** */
@@ -90,6 +111,12 @@ static void spawn_enemy(uint32 enemy_type, uint32 corridor_index, int32 world_z)
 static uint32 get_enemy_corridor(uint32 enemy_type);
 static void load_enemy_anims(void);
 static void activate_spike(vec3f16 end_pos, uint32 corridor_index);
+static void group_enemy(enemy_typ_ptr enemy);
+static void ungroup_enemy(enemy_typ_ptr enemy);
+static void animate_enemy_group(uint32 enemy_type);
+static void set_enemy_frame(enemy_typ_ptr enemy, anim_frame_typ_ptr frame);
+static void build_anim_cycle(cel_anim_typ_ptr anims, int32 *cycle_lut);
+static void end_zapped_anim(enemy_typ_ptr enemy);
 // Init calls
 static void init_flipper(enemy_typ_ptr enemy);
 static void init_spiker(enemy_typ_ptr enemy);
@@ -124,6 +151,9 @@ void clear_enemies(void)
     for (i = 0; i < MAX_ENEMIES; i++)
         enemies[i].state = ES_INACTIVE;
 
+    pool_reset(&enemy_pool);
+    clear_corridor_enemies();
+
     memset((void*)hostile_stats.enemy_counts, 0, sizeof(uint32) * MAX_ENEMY_TYPES);
 
     killshot_enemy = 0;
@@ -146,6 +176,7 @@ void init_enemies(void)
     {        
         enemy->state = ES_INACTIVE;
         enemy->obj = load_obj("Assets/Entities/Billboard");
+        enemy->obj->priority = OBJ_PRIORITY_ENEMY;
         scale_obj(enemy->obj, ENEMY_BILLBOARD_S);
         clone_vertex_def(&enemy->obj->vertex_def_copy, &enemy->obj->vertex_def);
         enemy->obj->polygons[0].ccb = create_coded_cel8(ENEMY_BILLBOARD_W, ENEMY_BILLBOARD_H, FALSE);
@@ -154,6 +185,10 @@ void init_enemies(void)
         ++enemy;
     }
 
+    pool_reset(&enemy_pool);
+    pool_reset(&spike_pool);
+    clear_corridor_enemies();
+
     // Enemy init function pointers
     init_enemy_handlers[FLIPPER] = init_flipper;
     init_enemy_handlers[MISSILE] = init_missile;
@@ -177,75 +212,50 @@ void init_enemies(void)
 
 void update_enemies(uint32 delta_time)
 {
-    uint32 i;
+    uint32 i, type;
+    uint16 *group;
     enemy_typ_ptr enemy;
-    Boolean animate;
-    int32 lut_index;
-    cel_anim_typ_ptr anims;
+    Boolean anim_tick;
+    void (*update)(enemy_typ_ptr, uint32);
 
-    if (is_simple_timer_ready(&anim_timer, time_io))
-    {
-        animate = TRUE;
-        reset_simple_timer(&anim_timer, time_io);
-    }
-    else 
-    {
-        animate = FALSE;
-    }
+    // One animation clock for every enemy, frames only move when it ticks
+    anim_tick = is_simple_timer_ready(&anim_timer, time_io);
 
-    enemy = enemies;
-    i = MAX_ENEMIES;
+    if (anim_tick)
+        reset_simple_timer(&anim_timer, time_io);
 
-    while (i-- > 0)
+    /*  One type at a time so the handler and animation stay the same for the whole loop. 
+        Payloads spawn lower numbered types, which have already been updated this frame. */
+    for (type = 0; type < MAX_ENEMY_TYPES; type++)
     {
-        if (enemy->state != ES_INACTIVE)
-        {
-            if (enemy->state == ES_ACTIVE)
-                anims = &enemy_anims[enemy->enemy_type];
-            else
-                anims = &zapped_anim;
-            
-            if (anims->frame_cycle_lut[enemy->frame_index] < 0)
-                enemy->frame_index = 0;
+        if (hostile_stats.enemy_counts[type] == 0)
+            continue;
 
-            lut_index = anims->frame_cycle_lut[enemy->frame_index];
+        if (anim_tick)
+            animate_enemy_group(type);
 
-            enemy->obj->polygons[0].ccb->ccb_SourcePtr = (CelData*) anims->frames[lut_index]->source;
-            enemy->obj->polygons[0].ccb->ccb_PLUTPtr = (void*) anims->frames[lut_index]->plut;
+        group = type_slots[type];
+        update = enemy_update_handlers[type];
 
-            if (animate)
-            {
-                ++enemy->frame_index;                
+        // From the end, destroy_enemy moves the last of the group into the slot being updated
+        i = hostile_stats.enemy_counts[type];
 
-                if (anims->frame_cycle_lut[enemy->frame_index] < 0)
-                {
-                    enemy->frame_index = 0;      
-                                  
-                    if (enemy->state == ES_DESTROY)
-                        destroy_enemy(enemy, FALSE);
-                }
-            }
+        while (i-- > 0)
+        {
+            enemy = &enemies[ group[i] ];
 
             if (enemy->state == ES_ACTIVE)
-                enemy_update_handlers[enemy->enemy_type](enemy, delta_time);  
+                update(enemy, delta_time);  
         }
-
-        ++enemy;
     }
 }
 
 void add_enemies(void)
 {
-    uint32 i = MAX_ENEMIES;
-    enemy_typ_ptr enemy = enemies;    
-
-    while (i-- > 0)
-    {
-        if (enemy->state != ES_INACTIVE)
-            add_obj(enemy->obj, TRUE);
+    uint32 i;
 
-        enemy++;
-    }
+    for (i = 0; i < enemy_pool.active_count; i++)
+        add_obj(enemies[POOL_SLOT(&enemy_pool, i)].obj, TRUE);
 }
 
 void spawn_next_enemy(void)
@@ -281,49 +291,45 @@ void spawn_next_enemy(void)
     // Get starting corridor
     corridor_index = get_enemy_corridor(spawn_type);
 
+    // Every corridor is taken, send a missile instead
+    if (corridor_index == CORRIDOR_NONE)
+    {
+        spawn_type = MISSILE;
+        corridor_index = get_enemy_corridor(spawn_type);
+    }
+
     spawn_enemy(spawn_type, corridor_index, LEVEL_ZFAR);
 }
 
 void activate_spike(vec3f16 end_pos, uint32 corridor_index)
 {
-    uint32 i = MAX_SPIKES;
-    spike_typ_ptr spike = spikes;
+    uint32 slot = pool_alloc(&spike_pool);
+    spike_typ_ptr spike;
 
-    #if DEBUG_MODE
-        Boolean slot_found = FALSE;
-    #endif
-
-    while (i--)
+    if (slot == POOL_NONE)
     {
-        if (!spike->active)
-        {
-            spike->active = TRUE;
-            spike->corridor_index = corridor_index;
-            
-            spike->begin_pos[0] = end_pos[0];
-            spike->begin_pos[1] = end_pos[1];
-            spike->begin_pos[2] = LEVEL_ZFAR;
-
-            spike->end_pos[0] = end_pos[0];
-            spike->end_pos[1] = end_pos[1];
-            spike->end_pos[2] = end_pos[2];
-     
-            ++hostile_stats.active_spikes;
-
-            #if DEBUG_MODE
-                slot_found = TRUE;
-            #endif
-
-            break;
-        }
+        #if DEBUG_MODE 
+            printf("Error - Unable to spawn new spike. No more room.\n");
+        #endif
 
-        ++spike;
+        return;
     }
 
-    #if DEBUG_MODE 
-        if (!slot_found)
-            printf("Error - Unable to spawn new spike. No more room.\n");
-    #endif
+    spike = &spikes[slot];
+    spike->active = TRUE;
+    spike->corridor_index = corridor_index;
+    
+    spike->begin_pos[0] = end_pos[0];
+    spike->begin_pos[1] = end_pos[1];
+    spike->begin_pos[2] = LEVEL_ZFAR;
+
+    spike->end_pos[0] = end_pos[0];
+    spike->end_pos[1] = end_pos[1];
+    spike->end_pos[2] = end_pos[2];
+
+    index_spike(spike);
+
+    ++hostile_stats.active_spikes;
 }
 
 void damage_spike(spike_typ_ptr spike)
@@ -337,6 +343,8 @@ void damage_spike(spike_typ_ptr spike)
     {
         // Destroy
         spike->active = FALSE;
+        unindex_spike(spike);
+        pool_release(&spike_pool, spike - spikes);
         --hostile_stats.active_spikes;
     }
 }
@@ -345,11 +353,11 @@ void draw_spikes(void)
 {
     static GrafCon gcon;
     static Boolean first_run = TRUE;
-    vec3f16 point_cam;    
-    Point sc_begin;
-    Point sc_end;    
-    uint32 i = MAX_SPIKES;
-    spike_typ_ptr spike = spikes;
+    static vec3f16 ends[MAX_SPIKES * 2];
+    static Point screen_ends[MAX_SPIKES * 2];
+    uint32 i;
+    spike_typ_ptr spike;
+    uint32 count = 0;
 
     if (first_run)
     {
@@ -357,37 +365,25 @@ void draw_spikes(void)
         SetFGPen(&gcon, MakeRGB15(0,0,31));
     }
 
-    while (i-- > 0)
+    // Gather both end points of every active spike, then project them together
+    for (i = 0; i < spike_pool.active_count; i++)
     {
-        if (spike->active)
-        {
-            // Point A
-
-            point_to_camera(point_cam, spike->begin_pos);
-
-            if (point_cam[2] < CAM_NEAR)
-                point_cam[2] = CAM_NEAR;
-
-            point_to_screen(&sc_begin, point_cam, TRUE);
-            
-            // Point B
-            
-            point_to_camera(point_cam, spike->end_pos);
-
-            if (point_cam[2] < CAM_NEAR)
-                point_cam[2] = CAM_NEAR;
-
-            point_to_screen(&sc_end, point_cam, TRUE);
+        spike = &spikes[POOL_SLOT(&spike_pool, i)];
+        memcpy((void*)ends[count++], (void*)spike->begin_pos, sizeof(vec3f16));
+        memcpy((void*)ends[count++], (void*)spike->end_pos, sizeof(vec3f16));
+    }
 
-            // Draw line
+    if (count == 0)
+        return;
 
-            gcon.gc_PenX = sc_begin.pt_X;
-            gcon.gc_PenY = sc_begin.pt_Y;
+    points_to_screen(screen_ends, ends, count, CAM_NEAR);
 
-            DrawTo(SCONTEXT_BITEM, &gcon, sc_end.pt_X, sc_end.pt_Y);  
-        }
+    for (i = 0; i < count; i += 2)
+    {
+        gcon.gc_PenX = screen_ends[i].pt_X;
+        gcon.gc_PenY = screen_ends[i].pt_Y;
 
-        ++spike;
+        DrawTo(SCONTEXT_BITEM, &gcon, screen_ends[i + 1].pt_X, screen_ends[i + 1].pt_Y);  
     }
 }
 
@@ -407,10 +403,12 @@ void destroy_enemy(enemy_typ_ptr enemy, Boolean payload)
     if (enemy->enemy_type == PULSAR)
         reset_corridor(enemy->corridor_index);
 
-    --hostile_stats.enemy_counts[enemy->enemy_type];
+    ungroup_enemy(enemy);
     --hostile_stats.active_enemies;
 
     enemy->state = ES_INACTIVE;
+    unindex_enemy(enemy);
+    pool_release(&enemy_pool, enemy - enemies);
 
     if (payload)
     {
@@ -465,7 +463,7 @@ void init_tanker(enemy_typ_ptr enemy)
 
 void init_fuseball(enemy_typ_ptr enemy)
 {
-    poly_props_typ props;
+    corridor_typ_ptr corridor;
 
     enemy->health = 1;
     enemy->speed = 1;
@@ -474,17 +472,17 @@ void init_fuseball(enemy_typ_ptr enemy)
 
     enemy->traversal_order = (rand() % 2) ? CCW : CW;
 
-    props = get_corridor_props(&LCONTEXT_LEVEL.obj->polygons[enemy->corridor_index]);
+    corridor = get_corridor(enemy->corridor_index);
 
     if (rand() % 2)
     {
-        enemy->obj->world_x = props.near_edge[0][0];
-        enemy->obj->world_y = props.near_edge[0][1];        
+        enemy->obj->world_x = corridor->near_edge[0][0];
+        enemy->obj->world_y = corridor->near_edge[0][1];        
     }
     else
     {
-        enemy->obj->world_x = props.near_edge[2][0];
-        enemy->obj->world_y = props.near_edge[2][1];
+        enemy->obj->world_x = corridor->near_edge[2][0];
+        enemy->obj->world_y = corridor->near_edge[2][1];
     }
 }
 
@@ -619,22 +617,8 @@ void update_fuseball(enemy_typ_ptr enemy, uint32 delta_time)
 
 void spawn_enemy(uint32 enemy_type, uint32 corridor_index, int32 world_z)
 {    
-    uint32 i;
-    int32 lut_index;
-    enemy_typ_ptr enemy = NULL;
-        
-    for (i = 0; i < MAX_ENEMIES; i++)
-    {
-        if (enemies[i].state == ES_INACTIVE)
-        {
-            enemy = &enemies[i];
-            break;
-        }
-    }
-
-    // Ensure we have an enemy slot available.
-    if (!enemy)
-        return;
+    uint32 slot;
+    enemy_typ_ptr enemy;
     
     // If spiker, ensure we have enough space.
     if (enemy_type == SPIKER)
@@ -643,85 +627,134 @@ void spawn_enemy(uint32 enemy_type, uint32 corridor_index, int32 world_z)
             return;
     }
 
+    slot = pool_alloc(&enemy_pool);
+
+    // Ensure we have an enemy slot available.
+    if (slot == POOL_NONE)
+        return;
+
     // OK 
 
+    enemy = &enemies[slot];
+
     enemy->enemy_type = enemy_type;
     enemy->frame_index = 0;
-    lut_index = enemy_anims[enemy->enemy_type].frame_cycle_lut[enemy->frame_index];
-
-    enemy->obj->polygons[0].ccb->ccb_SourcePtr = (CelData*) enemy_anims[enemy->enemy_type].frames[lut_index]->source;    
-    enemy->obj->polygons[0].ccb->ccb_PLUTPtr = (void*) enemy_anims[enemy->enemy_type].frames[lut_index]->plut;
+    set_enemy_frame(enemy, &enemy_anims[enemy->enemy_type].cycle[0]);
 
     enemy->corridor_index = corridor_index;
-    snap_obj_to_corridor(enemy->obj, &LCONTEXT_LEVEL.obj->polygons[enemy->corridor_index], world_z);
+    snap_obj_to_corridor(enemy->obj, enemy->corridor_index, world_z);
+    index_enemy(enemy);
 
     init_enemy_handlers[enemy->enemy_type](enemy);   
 
-    ++hostile_stats.enemy_counts[enemy->enemy_type];
+    group_enemy(enemy);
     ++hostile_stats.active_enemies;
 
     enemy->state = ES_ACTIVE;
 }
 
-uint32 get_enemy_corridor(uint32 enemy_type)
+void group_enemy(enemy_typ_ptr enemy)
 {
-    uint32 corridor_index = 0;
+    uint32 slot = enemy - enemies;
+    uint32 *count = &hostile_stats.enemy_counts[enemy->enemy_type];
 
-    if (enemy_type == SPIKER)
+    type_positions[slot] = (uint16) *count;
+    type_slots[enemy->enemy_type][*count] = (uint16) slot;
+    ++(*count);
+}
+
+void ungroup_enemy(enemy_typ_ptr enemy)
+{
+    uint16 *group = type_slots[enemy->enemy_type];
+    uint32 *count = &hostile_stats.enemy_counts[enemy->enemy_type];
+    uint32 position = type_positions[enemy - enemies];
+
+    // Move the last of the group into the gap
+    --(*count);
+    group[position] = group[*count];
+    type_positions[ group[position] ] = (uint16) position;
+}
+
+void animate_enemy_group(uint32 enemy_type)
+{
+    uint32 i;
+    uint16 *group = type_slots[enemy_type];
+    anim_frame_typ_ptr last;
+    enemy_typ_ptr enemy;
+    cel_anim_typ_ptr anims;
+
+    // From the end, an on_end call may destroy the enemy and shrink the group
+    i = hostile_stats.enemy_counts[enemy_type];
+
+    while (i-- > 0)
     {
-        uint32 i;
-        Boolean corridor_found;
+        enemy = &enemies[ group[i] ];
+        anims = (enemy->state == ES_ACTIVE) ? &enemy_anims[enemy_type] : &zapped_anim;
+        last = &anims->cycle[enemy->frame_index];
 
-        // Find a corridor without a spike or spiker.
-        do 
+        if (++enemy->frame_index >= anims->cycle_length)
         {
-            corridor_index = rand() % LCONTEXT_LEVEL.obj->poly_count;
-            corridor_found = TRUE; // Test below
+            enemy->frame_index = 0;
 
-            for (i = 0; i < MAX_SPIKES; i++)
+            if (anims->on_end)
             {
-                if (spikes[i].active)
-                {
-                    if (spikes[i].corridor_index == corridor_index)
-                    {
-                        // Try again
-                        corridor_found = FALSE;
-                        break; 
-                    }
-                }
+                anims->on_end(enemy);
+                continue;
             }
+        }
 
-            if (!corridor_found)
-                continue;
+        // Single frame cycles never write the CCB
+        if (anims->cycle[enemy->frame_index].source != last->source)
+            set_enemy_frame(enemy, &anims->cycle[enemy->frame_index]);
+    }
+}
 
-            for (i = 0; i < MAX_ENEMIES; i++)
-            {
-                if (enemies[i].state == ES_ACTIVE)
-                {
-                    if (enemies[i].corridor_index == corridor_index)
-                    {
-                        // Try again
-                        corridor_found = FALSE;
-                        break;
-                    }
-                }
-            }
-        } while(!corridor_found);
-    }    
-    else 
+void set_enemy_frame(enemy_typ_ptr enemy, anim_frame_typ_ptr frame)
+{
+    CCB *ccb = enemy->obj->polygons[0].ccb;
+
+    ccb->ccb_SourcePtr = frame->source;
+    ccb->ccb_PLUTPtr = frame->plut;
+}
+
+void build_anim_cycle(cel_anim_typ_ptr anims, int32 *cycle_lut)
+{
+    uint32 i;
+
+    for (i = 0; i < MAX_ANIM_CYCLE && cycle_lut[i] >= 0; i++)
     {
-        corridor_index = rand() % LCONTEXT_LEVEL.obj->poly_count;
+        anims->cycle[i] = anims->frames[ cycle_lut[i] ];
     }
 
+    anims->cycle_length = i;
+    anims->on_end = NULL;
+}
+
+void end_zapped_anim(enemy_typ_ptr enemy)
+{
+    destroy_enemy(enemy, FALSE);
+}
+
+uint32 get_enemy_corridor(uint32 enemy_type)
+{
+    uint32 corridor_index;
+
+    // Spikers need a corridor without a spike or enemy
+    if (enemy_type == SPIKER)
+        corridor_index = get_free_corridor();
+    else 
+        corridor_index = rand() % LCONTEXT_LEVEL.obj->poly_count;
+
     return(corridor_index);
 }
 
 void load_enemy_anims(void)
 {
-    uint32 i, j;
-    CCB *temp_ccb;
+    uint32 i;
+    uint32 frame_bytes;
+    CCB *ccb;
+    anim_frame_typ_ptr frame;
     rez_envelope_typ rez_envelope;    
-    char buffer[50];
     
     enemy_anims[FLIPPER].frame_count = 1;
     enemy_anims[TANKER].frame_count = 3;
@@ -731,54 +764,55 @@ void load_enemy_anims(void)
     enemy_anims[PULSAR].frame_count = 1;
     enemy_anims[FTANKER].frame_count = 3;
     enemy_anims[PTANKER].frame_count = 3;
+    zapped_anim.frame_count = 3;    
 
-    for (i = 0; i < MAX_ENEMY_TYPES; i++)
-    {
-        enemy_anims[i].frames = (cel8_data_typ_ptr*) AllocMem(sizeof(cel8_data_typ) * enemy_anims[i].frame_count, MEMTYPE_DRAM);
+    // One file holds every frame, see build_assets.sh
+    load_resource("Assets/Graphics/Enemies.cel", REZ_CEL_LIST, &rez_envelope);
+    ccb = (CCB*) rez_envelope.data;
 
-        for (j = 0; j < enemy_anims[i].frame_count; j++)
-        {
-            sprintf(buffer, "Assets/Graphics/%s/%s%d.cel", enemy_names[i], enemy_names[i], j+1);
+    frame_bytes = get_cel_src_bytes(ccb);
+    atlas_source = (ubyte*) AllocMem(frame_bytes * ENEMY_ATLAS_FRAMES, MEMTYPE_DRAM);
 
-            load_resource(buffer, REZ_CEL, &rez_envelope);            
-            temp_ccb = (CCB*) rez_envelope.data;
+    for (i = 0; i < ENEMY_ATLAS_FRAMES; i++)
+    {
+        #if DEBUG_MODE
+            if (!ccb || get_cel_src_bytes(ccb) != frame_bytes)
+                printf("Error - Enemy frame %d does not match the atlas.\n", i);
+        #endif
 
-            enemy_anims[i].frames[j] = cel_3do_to_cel8_data(temp_ccb);
+        memcpy((void*)(atlas_source + i * frame_bytes), (void*)ccb->ccb_SourcePtr, frame_bytes);
+        memcpy((void*)atlas_pluts[i], (void*)ccb->ccb_PLUTPtr, sizeof(uint16) * 32);
 
-            unload_resource(&rez_envelope, REZ_CEL);      
-        }
+        atlas_frames[i].source = (CelData*) (atlas_source + i * frame_bytes);
+        atlas_frames[i].plut = (void*) atlas_pluts[i];
 
-        memcpy((void*)enemy_anims[i].frame_cycle_lut, (void*)frame_cycle_luts[i], sizeof(int32) * MAX_ANIM_CYCLE);       
+        ccb = ccb->ccb_NextPtr;
     }
 
-    // Anim used when super zapper is used
+    unload_resource(&rez_envelope, REZ_CEL_LIST);
 
-    zapped_anim.frame_count = 3;    
-    zapped_anim.frames = (cel8_data_typ_ptr*) AllocMem(sizeof(cel8_data_typ) * zapped_anim.frame_count, MEMTYPE_DRAM);
+    frame = atlas_frames;
 
-    for (i = 0; i < zapped_anim.frame_count; i++)
+    for (i = 0; i < MAX_ENEMY_TYPES; i++)
     {
-        sprintf(buffer, "Assets/Graphics/Effects/Zapped%d.cel", i+1);
-        load_resource(buffer, REZ_CEL, &rez_envelope);
-        temp_ccb = (CCB*) rez_envelope.data;
-        zapped_anim.frames[i] = cel_3do_to_cel8_data(temp_ccb);
-        unload_resource(&rez_envelope, REZ_CEL);
-    }
+        enemy_anims[i].frames = frame;
+        frame += enemy_anims[i].frame_count;
 
-    memset((void*)zapped_anim.frame_cycle_lut, -1, sizeof(int32) * MAX_ANIM_CYCLE);       
+        build_anim_cycle(&enemy_anims[i], frame_cycle_luts[i]);
+    }
 
-    zapped_anim.frame_cycle_lut[0] = 2;
-    zapped_anim.frame_cycle_lut[1] = 1;
-    zapped_anim.frame_cycle_lut[2] = 0;
-    zapped_anim.frame_cycle_lut[3] = 1;
-    zapped_anim.frame_cycle_lut[4] = 2; 
-    zapped_anim.frame_cycle_lut[5] = -1; 
+    // Anim used when super zapper is used
+    zapped_anim.frames = frame;
+    build_anim_cycle(&zapped_anim, zapped_cycle_lut);
+    zapped_anim.on_end = end_zapped_anim;
 }
 
 void clear_hostiles(void)
 {
     clear_enemies();
     memset((void*)spikes, 0, sizeof(spike_typ) * MAX_SPIKES);
+    pool_reset(&spike_pool);
+    clear_corridor_spikes();
     memset((void*)&hostile_stats, 0, sizeof(hostile_stats));
 }
 
@@ -867,7 +901,7 @@ Boolean mb_roll(enemy_typ_ptr enemy, uint32 delta_time)
     vec3f16 up;
     vertex_typ_ptr vt;
     polygon_typ_ptr poly;
-    poly_props_typ props;
+    corridor_typ_ptr corridor;
 
     if (enemy->logical_flag) // Get next step
     {
@@ -902,15 +936,15 @@ Boolean mb_roll(enemy_typ_ptr enemy, uint32 delta_time)
         enemy->logical_flag = FALSE;
     }
 
-    props = get_corridor_props(&LCONTEXT_LEVEL.obj->polygons[enemy->corridor_index]);
+    corridor = get_corridor(enemy->corridor_index);
 
     if (enemy->traversal_order == CW)
     {            
-        rotate_obj_pivot_z(enemy->obj, props.near_edge[0], -196608);
+        rotate_obj_pivot_z(enemy->obj, corridor->near_edge[0], -196608);
     }
     else // CCW
     {
-        rotate_obj_pivot_z(enemy->obj, props.near_edge[2], 196608);
+        rotate_obj_pivot_z(enemy->obj, corridor->near_edge[2], 196608);
     }
 
     // Check if enemy rotated onto target corridor
@@ -923,6 +957,10 @@ Boolean mb_roll(enemy_typ_ptr enemy, uint32 delta_time)
     up[1] = vt[poly->vertex_lut[3]].vertex[VERTEX_Y] - vt[poly->vertex_lut[0]].vertex[VERTEX_Y];
     up[2] = 0;
 
+    // Vertices are in object space
+    rotate_obj_vector(enemy->obj, up, up);
+    up[2] = 0;
+
     normalize_vector(up);
 
     dp = Dot3_F16(up, enemy->vector);
@@ -932,7 +970,8 @@ Boolean mb_roll(enemy_typ_ptr enemy, uint32 delta_time)
     {
         // enemy->logical_flag = TRUE;
         enemy->corridor_index = enemy->next_corridor;
-        snap_obj_to_corridor(enemy->obj, &LCONTEXT_LEVEL.obj->polygons[enemy->corridor_index], LEVEL_ZNEAR);   
+        snap_obj_to_corridor(enemy->obj, enemy->corridor_index, LEVEL_ZNEAR);   
+        index_enemy(enemy);
         enemy->logical_flag = TRUE;
         return(TRUE);        
     }
@@ -942,7 +981,7 @@ Boolean mb_roll(enemy_typ_ptr enemy, uint32 delta_time)
 
 Boolean mb_side_step(enemy_typ_ptr enemy, uint32 delta_time)
 {
-    poly_props_typ props;
+    corridor_typ_ptr corridor;
     int32 speed;
     int32 dist;
     int32 next_corridor;
@@ -953,17 +992,17 @@ Boolean mb_side_step(enemy_typ_ptr enemy, uint32 delta_time)
     if (enemy->logical_flag)
     {
         // Get travel vector based on current corridor
-        props = get_corridor_props(&LCONTEXT_LEVEL.obj->polygons[enemy->corridor_index]);
+        corridor = get_corridor(enemy->corridor_index);
         
         if (enemy->traversal_order == CW)
         {
-            enemy->vector[X] = props.near_edge[0][X] - props.near_edge[2][X];
-            enemy->vector[Y] = props.near_edge[0][Y] - props.near_edge[2][Y];
+            enemy->vector[X] = corridor->near_edge[0][X] - corridor->near_edge[2][X];
+            enemy->vector[Y] = corridor->near_edge[0][Y] - corridor->near_edge[2][Y];
         }
         else // CCW
         {
-            enemy->vector[X] = props.near_edge[2][X] - props.near_edge[0][X];
-            enemy->vector[Y] = props.near_edge[2][Y] - props.near_edge[0][Y];
+            enemy->vector[X] = corridor->near_edge[2][X] - corridor->near_edge[0][X];
+            enemy->vector[Y] = corridor->near_edge[2][Y] - corridor->near_edge[0][Y];
         }
 
         enemy->vector[Z] = 0;
@@ -975,16 +1014,16 @@ Boolean mb_side_step(enemy_typ_ptr enemy, uint32 delta_time)
 
     // Has enemy crossed over onto next corridor?
 
-    props = get_corridor_props(&LCONTEXT_LEVEL.obj->polygons[enemy->corridor_index]);
+    corridor = get_corridor(enemy->corridor_index);
 
     p1[0] = enemy->obj->world_x;
     p1[1] = enemy->obj->world_y;
     p1[2] = 0;
 
     if (enemy->traversal_order == CW)
-        vertex = props.near_edge[0];
+        vertex = corridor->near_edge[0];
     else // CCW
-        vertex = props.near_edge[2];
+        vertex = corridor->near_edge[2];
 
     dist = get_squared_dist(p1, vertex);
 
@@ -1014,6 +1053,8 @@ Boolean mb_side_step(enemy_typ_ptr enemy, uint32 delta_time)
                 enemy->corridor_index = next_corridor;
         }
 
+        index_enemy(enemy);
+
         ret = TRUE;
     }
     else 
@@ -1036,18 +1077,16 @@ void zap_enemies(void)
     enemy_typ_ptr enemy_it;
     uint32 i;
 
-    enemy_it = enemies;
-    i = MAX_ENEMIES;
-
-    while (i--)
+    for (i = 0; i < enemy_pool.active_count; i++)
     {
+        enemy_it = &enemies[POOL_SLOT(&enemy_pool, i)];
+
         if (enemy_it->state == ES_ACTIVE)
         {
             enemy_it->state = ES_DESTROY;
             enemy_it->frame_index = 0;
+            set_enemy_frame(enemy_it, &zapped_anim.cycle[0]);
             reset_simple_timer(&anim_timer, time_io);
         }
-         
-        ++enemy_it;
     }
 }
\ No newline at end of file
@@ -105,7 +105,8 @@ void options_start(void)
     player_rot_amount = 0;
 
     // Reset player rotation
-    copy_vertex_def(&player.obj->vertex_def, &player.obj->vertex_def_copy);
+    reset_obj_vertices(player.obj, &player.obj->vertex_def_copy);
+    reset_obj_rotation(player.obj);
     scale_obj(player.obj, 16384);
 
     zero_camera();
@@ -174,15 +175,14 @@ int32 options_update(uint32 delta_time)
     rotate_obj(player.obj, rot_angles);
     player_rot_amount += 131072;
 
-    /*  We need to reset the vertices once a full rotation has completed, otherwise, 
-        over time, precision errors will alter the vertices just enough to alter
+    /*  We need to reset the rotation once a full rotation has completed, otherwise, 
+        over time, precision errors will skew the matrix just enough to alter
         the model's appearance. */
 
     if (player_rot_amount >= 11796480)
     {
         // Reset player rotation
-        copy_vertex_def(&player.obj->vertex_def, &player.obj->vertex_def_copy);
-        scale_obj(player.obj, 16384);
+        reset_obj_rotation(player.obj);
         player_rot_amount = 0;
     }
 
@@ -7,6 +7,7 @@
 #define DIGIT_ATLAS_HEIGHT 16
 #define DIGIT_WIDTH 14
 #define DIGIT_HEIGHT 16
+#define CEL_COST_FRAMES 120 // Frames between CEL cost reports
 
 // Powerup flags
 #define PUP_NONE 0
@@ -17,7 +18,7 @@
 /* *************************************************************************************** */
 
 Item *sfx[SFX_MAX];
-star_typ stars[MAX_STARS];
+starfield_typ stars;
 uint32 game_settings;
 
 /* *************************************************************************************** */
@@ -26,7 +27,7 @@ uint32 game_settings;
 
 void init_stars(void);
 void update_stars(void);
-void reset_star(star_typ *sptr);
+void reset_star(uint32 index);
 void showcase_ship(void);
 
 /* *************************************************************************************** */
@@ -34,7 +35,9 @@ void showcase_ship(void);
 /* *************************************************************************************** */
 
 static bullet_typ bullets[MAX_BULLETS];
+POOL_DEFINE(bullet_pool, MAX_BULLETS);
 static uint32 play_handler_index;
+static uint32 guard_counts[PLAY_HANDLER_MAX]; // Guard band hits since the handler was entered
 static void (*play_handlers[PLAY_HANDLER_MAX])(uint32);
 static uint32 obj_velocity; // Reusable velocity value
 static FontDescriptor *font_desc;
@@ -94,6 +97,9 @@ struct
 
 static void new_game(void);
 static void flip_display(void);
+#if SHOW_CEL_COST || CAPTURE_FRAMES
+static void measure_cel_cost(celcost_report_typ_ptr report);
+#endif
 static void clear_entities(void);
 static void draw_guides(void);
 static void update_life_hud(void);
@@ -188,14 +194,16 @@ void new_game(void)
 
     run_gstate_loop(title_start, title_update, title_stop);
 
-    // Always relink cels in case another state uses them
+    // Always rebuild the display list in case another state relinked these cels
 
-    LINK_CEL(lives[MAX_LIVES-1], watch_out);
-    LINK_CEL(watch_out, explode);
-    LINK_CEL(explode, score_cels[0]);
-    LINK_CEL(score_cels[MAX_ENEMY_TYPES-1], gover);
-    LINK_CEL(gover, score_num_cels[0]);
-    LINK_CEL(score_num_cels[MAX_SCORE_DIGITS-1], stars[0].ccb);    
+    dlist_reset();
+    dlist_append(DLIST_LAYER_HUD, lives[0], lives[MAX_LIVES-1]);
+    dlist_append(DLIST_LAYER_HUD, watch_out, watch_out);
+    dlist_append(DLIST_LAYER_HUD, explode, explode);
+    dlist_append(DLIST_LAYER_HUD, score_cels[0], score_cels[MAX_ENEMY_TYPES-1]);
+    dlist_append(DLIST_LAYER_OVERLAY, gover, gover);
+    dlist_append(DLIST_LAYER_OVERLAY, score_num_cels[0], score_num_cels[MAX_SCORE_DIGITS-1]);
+    dlist_append(DLIST_LAYER_OVERLAY, stars.ccbs[0], stars.ccbs[MAX_STARS-1]);
 
     #if SHOW_FPS
         // Fields per second.
@@ -204,10 +212,7 @@ void new_game(void)
         fps_tcel->tc_CCB->ccb_XPos = 12 << FRACBITS_16;
         fps_tcel->tc_CCB->ccb_YPos = 220 << FRACBITS_16;
         SetTextCelColor(fps_tcel, 0, MakeRGB15(0, 31, 0));
-        LINK_CEL(stars[MAX_STARS-1].ccb, fps_tcel->tc_CCB);
-        LAST_CEL(fps_tcel->tc_CCB);
-    #else 
-        LAST_CEL(stars[MAX_STARS-1].ccb);
+        dlist_append(DLIST_LAYER_OVERLAY, fps_tcel->tc_CCB, fps_tcel->tc_CCB);
     #endif           
 
     gover->ccb_Flags |= CCB_SKIP;
@@ -248,34 +253,30 @@ void new_game(void)
     set_play_handler(PLAY_HANDLER_INTRO);
 }
 
-void reset_star(star_typ *sptr)
+void reset_star(uint32 index)
 {
-    sptr->world[X] = (-2 + (rand() % 5)) << FRACBITS_16;
-    sptr->world[Y] = (-2 + (rand() % 5)) << FRACBITS_16;
-    sptr->world[Z] = (6 + rand() % 4) << FRACBITS_16;
+    stars.world[index][X] = (-2 + (rand() % 5)) << FRACBITS_16;
+    stars.world[index][Y] = (-2 + (rand() % 5)) << FRACBITS_16;
+    stars.world[index][Z] = (6 + rand() % 4) << FRACBITS_16;
 }
 
 void update_stars(void)
 {
     uint32 i;
-    Point screen_pos;
-    star_typ *sptr;
+    CCB *ccb;
+
+    points_to_screen(stars.screen, stars.world, MAX_STARS, 0);
 
     for (i = 0; i < MAX_STARS; i++)
     {   
-        sptr = &stars[i];
-
-        point_to_camera(sptr->cam, sptr->world);       
+        ccb = stars.ccbs[i];
+        ccb->ccb_XPos = stars.screen[i].pt_X << FRACBITS_16;
+        ccb->ccb_YPos = stars.screen[i].pt_Y << FRACBITS_16;
 
-        point_to_screen(&screen_pos, sptr->cam, TRUE);
+        stars.world[i][Z] -= 16384;
 
-        sptr->ccb->ccb_XPos = screen_pos.pt_X << FRACBITS_16;
-        sptr->ccb->ccb_YPos = screen_pos.pt_Y << FRACBITS_16;
-
-        stars[i].world[Z] -= 16384;
-
-        if (sptr->world[Z] <= camera.world_z)
-            reset_star(sptr);
+        if (stars.world[i][Z] <= camera.world_z)
+            reset_star(i);
     }
 }
 
@@ -283,22 +284,22 @@ void init_stars(void)
 {
     uint32 i;
 
-    stars[0].ccb = create_coded_colored_cel8(8, 8, MakeRGB15(28, 28, 28));
+    stars.ccbs[0] = create_coded_colored_cel8(8, 8, MakeRGB15(28, 28, 28));
     
     for (i = 0; i < MAX_STARS; i++)
     {
         if (i > 0)
         {
-            stars[i].ccb = create_coded_cel8(8, 8, FALSE);
-            stars[i].ccb->ccb_SourcePtr = stars[0].ccb->ccb_SourcePtr;
-            stars[i].ccb->ccb_PLUTPtr = stars[0].ccb->ccb_PLUTPtr;           
-            LINK_CEL(stars[i-1].ccb, stars[i].ccb);
+            stars.ccbs[i] = create_coded_cel8(8, 8, FALSE);
+            stars.ccbs[i]->ccb_SourcePtr = stars.ccbs[0]->ccb_SourcePtr;
+            stars.ccbs[i]->ccb_PLUTPtr = stars.ccbs[0]->ccb_PLUTPtr;           
+            LINK_CEL(stars.ccbs[i-1], stars.ccbs[i]);
         }
 
-        stars[i].ccb->ccb_HDX = 209715;
-        stars[i].ccb->ccb_VDY = 13107;
+        stars.ccbs[i]->ccb_HDX = 209715;
+        stars.ccbs[i]->ccb_VDY = 13107;
 
-        reset_star(&stars[i]);
+        reset_star(i);
     }
 }
 
@@ -308,8 +309,28 @@ void clear_entities(void)
     clear_hostiles();
 }
 
+#if SHOW_CEL_COST || CAPTURE_FRAMES
+void measure_cel_cost(celcost_report_typ_ptr report)
+{
+    uint32 i;
+    dlist_layer_typ_ptr lptr;
+
+    celcost_reset(report);
+
+    for (i = 0; i < DLIST_MAX_LAYERS; i++)
+    {
+        lptr = dlist_get_layer(i);
+
+        if (lptr->first && !lptr->hidden)
+            celcost_add_chain(report, i, lptr->first, lptr->last);
+    }
+}
+#endif
+
 void flip_display(void)
 {
+    guard_counts[play_handler_index] += render_stats.polys_guard_clipped + render_stats.polys_guard_rejected;
+
     #if SHOW_FPS
         static uint32 last_fields_sec = 0;
         char buffer[6];
@@ -327,6 +348,62 @@ void flip_display(void)
         draw_obj_normals(SCONTEXT_BITEM, LCONTEXT_LEVEL.obj);
     #endif
 
+    #if SHOW_RENDER_STATS
+    {
+        static GrafCon stats_gcon;
+        char stats_buf[48];
+
+        stats_gcon.gc_PenX = 8;
+        stats_gcon.gc_PenY = 8;
+
+        sprintf(stats_buf, "REUSE %d CALC %d", render_stats.polys_reused, render_stats.polys_recomputed);
+        DrawText8(&stats_gcon, SCONTEXT_BITEM, (uint8 *) stats_buf);
+
+        stats_gcon.gc_PenX = 8;
+        stats_gcon.gc_PenY = 18;
+
+        sprintf(stats_buf, "CULL %d DRAW %d BACK %d", render_stats.objs_culled, render_stats.objs_drawn, render_stats.polys_backfaced);
+        DrawText8(&stats_gcon, SCONTEXT_BITEM, (uint8 *) stats_buf);
+
+        stats_gcon.gc_PenX = 8;
+        stats_gcon.gc_PenY = 28;
+
+        sprintf(stats_buf, "DROP %d PEAK %d CLIP %d LINK %d", render_stats.polys_dropped, render_stats.queue_high_water, 
+            render_stats.polys_clipped, render_stats.links_rewritten);
+        DrawText8(&stats_gcon, SCONTEXT_BITEM, (uint8 *) stats_buf);
+
+        stats_gcon.gc_PenX = 8;
+        stats_gcon.gc_PenY = 38;
+
+        sprintf(stats_buf, "GUARD %d/%d HANDLER %d", render_stats.polys_guard_clipped, render_stats.polys_guard_rejected, 
+            guard_counts[play_handler_index]);
+        DrawText8(&stats_gcon, SCONTEXT_BITEM, (uint8 *) stats_buf);
+    }
+    #endif
+
+    #if SHOW_CEL_COST || CAPTURE_FRAMES
+    {
+        static uint32 cost_frames = 0;
+        celcost_report_typ report;
+        char label[24];
+
+        measure_cel_cost(&report);
+        ++cost_frames;
+
+        #if CAPTURE_FRAMES
+            // Keep the frame with the most fill for capture_dump
+            capture_frame(cost_frames, report.total.screen_pixels + report.total.source_pixels);
+        #endif
+
+        // Printing is slow, so only sample now and then
+        if (SHOW_CEL_COST && (cost_frames % CEL_COST_FRAMES) == 0)
+        {
+            sprintf(label, "handler %d", play_handler_index);
+            celcost_print(&report, label);
+        }
+    }
+    #endif
+
         #if 0
         {
             static GrafCon gcon;
@@ -366,7 +443,7 @@ void switch_handler(uint32 delta_time)
 {
     vec3f16 angles;
     int32 step;
-    uint32 i;
+    spike_typ_ptr spike;
 
     do_switch_input(delta_time);
     service_sample_player();
@@ -391,20 +468,12 @@ void switch_handler(uint32 delta_time)
         obj_velocity += 9830;
 
         // Check for spike collision
-        for (i = 0; i < MAX_SPIKES; i++)
+        spike = get_corridor_spike(player.corridor_index);
+
+        if (spike && player.obj->world_z >= spike->end_pos[2])
         {
-            if (spikes[i].active)
-            {
-                if (spikes[i].corridor_index == player.corridor_index)
-                {
-                    if (player.obj->world_z >= spikes[i].end_pos[2])
-                    {
-                        // Boom!
-                        player_hit(0);                        
-                        break;
-                    }
-                }
-            }
+            // Boom!
+            player_hit(0);                        
         }
     }
     else 
@@ -463,7 +532,7 @@ void switch_handler(uint32 delta_time)
     
     end_3d();
     
-    raster_scene(NULL, NULL, lives[0]);
+    raster_scene();
     draw_spikes();
     flip_display();
 }
@@ -476,9 +545,11 @@ void over_handler(uint32 delta_time)
 
     SetVRAMPages(sport_io, SCONTEXT_BITMAP, 0, sc->sc_NumBitmapPages, ~0);
 
+    // Nothing 3D is drawn, end_3d empties the layer left over from the last frame of play
     begin_3d();
-    raster_scene(NULL, NULL, gover);
     end_3d();
+
+    raster_scene();
     
     flip_display();
 
@@ -505,7 +576,7 @@ void grab_handler(uint32 delta_time)
     add_enemies();
     add_obj(player.obj, FALSE);
     end_3d();
-    raster_scene(NULL, NULL, lives[0]);
+    raster_scene();
     draw_spikes();
     flip_display();
 
@@ -569,7 +640,7 @@ void hit_handler(uint32 delta_time)
 
     add_obj(player.obj, FALSE);
     end_3d();
-    raster_scene(NULL, NULL, lives[0]);
+    raster_scene();
     draw_spikes();
     flip_display();
 
@@ -612,7 +683,7 @@ void intro_handler(uint32 delta_time)
         {
             // Finished
             LCONTEXT_LEVEL.obj->world_z = 0;
-            copy_vertex_def(&LCONTEXT_LEVEL.obj->vertex_def, &LCONTEXT_LEVEL.obj->vertex_def_copy);
+            reset_obj_rotation(LCONTEXT_LEVEL.obj);
             set_play_handler(PLAY_HANDLER_GAME);
         }
         else 
@@ -757,7 +828,7 @@ void game_handler(uint32 delta_time)
         add_enemies();
     end_3d();
 
-    raster_scene(NULL, NULL, lives[0]);
+    raster_scene();
     draw_spikes();
     draw_guides();
 
@@ -822,19 +893,21 @@ void do_game_input_pad(uint32 delta_time)
 	{	
         step_amount = MulSF16(BASE_MOVE_SPEED + player_move_vel, delta_time);
 
+        // Vertices are in object space, the corridor rotation is applied at projection
         if (BUTTONS & ControlRight)
         {
-            angle = -player.rotation_angle;
+            angle = 0;
             // printf("going right %d\n", angle);
         }
         else 
         {
-            angle = -player.rotation_angle + ANG_128;
+            angle = ANG_128;
             // printf("going left %d\n", angle);
         }
 
         trans_vertex_xy_by(verts[poly->vertex_lut[0]].vertex, step_amount, angle);
         trans_vertex_xy_by(verts[poly->vertex_lut[1]].vertex, step_amount, angle);
+        MARK_OBJ_DIRTY(player.obj);
 
         p1[0] = player.obj->world_x;
         p1[1] = player.obj->world_y;
@@ -940,13 +1013,15 @@ void do_game_input_mouse(uint32 delta_time)
 
         step_amount = ABS_VALUE(step_amount);
 
+        // Vertices are in object space, the corridor rotation is applied at projection
         if (mdx > 0)    // Right
-            angle = -player.rotation_angle;
+            angle = 0;
         else            // Left
-            angle = -player.rotation_angle + ANG_128;
+            angle = ANG_128;
 
         trans_vertex_xy_by(verts[poly->vertex_lut[0]].vertex, step_amount, angle);
         trans_vertex_xy_by(verts[poly->vertex_lut[1]].vertex, step_amount, angle);
+        MARK_OBJ_DIRTY(player.obj);
 
         p1[0] = player.obj->world_x;
         p1[1] = player.obj->world_y;
@@ -1070,6 +1145,7 @@ void load_bullets(void)
     memset((void*)bullets, 0, sizeof(bullet_typ) * MAX_BULLETS);
 
     bullets[0].obj = load_obj("Assets/Entities/Billboard");
+    bullets[0].obj->priority = OBJ_PRIORITY_ENEMY; // Shots share the hostiles' tier
     scale_obj(bullets[0].obj, 6553);
 
     bullets[0].obj->polygons[0].ccb = create_coded_colored_cel8(8, 8, MakeRGB15(31,31,0));
@@ -1086,6 +1162,8 @@ void load_bullets(void)
         FastMapCelInit(bullets[i].obj->polygons[0].ccb);
     }
 
+    pool_reset(&bullet_pool);
+
     // Set up volley
 
     angle = 0;
@@ -1093,17 +1171,16 @@ void load_bullets(void)
 
     for (i = 0; i < MAX_BULLETS; i++)
     {
-        volley_adj[i].pt_X = MulSF16(CosF16(angle), 6000); // Scale it down
-        volley_adj[i].pt_Y = MulSF16(SinF16(angle), 9000);
+        volley_adj[i].pt_X = MulSF16(cos_f16(angle), 6000); // Scale it down
+        volley_adj[i].pt_Y = MulSF16(sin_f16(angle), 9000);
         angle += angle_inc;
     }
 }
 
 void fire_bullet(void)
 {
-    // uint32 i = MAX_BULLETS;
-    uint32 i;
-    bullet_typ_ptr bullet = bullets;
+    uint32 slot;
+    bullet_typ_ptr bullet;
 
     if (!player.active)
         return;
@@ -1112,32 +1189,26 @@ void fire_bullet(void)
         return;
 
     // Hard mode gets 1 less bullet
-    i = (game_settings & GAME_SET_HARD_MASK) ? (MAX_BULLETS - 2) : MAX_BULLETS;
-    
-    while (i--) 
+    if (bullet_pool.active_count < ((game_settings & GAME_SET_HARD_MASK) ? (MAX_BULLETS - 2) : MAX_BULLETS))
     {
-        if (!bullet->active)
-        {
-            bullet->obj->world_x = player.obj->world_x;
-            bullet->obj->world_y = player.obj->world_y;
-            bullet->obj->world_z = player.obj->world_z;
-            bullet->corridor_index = player.corridor_index;
-            bullet->active = TRUE;
-            
-            bullet->obj->world_x += volley_adj[volley_index].pt_X;
-            bullet->obj->world_y += volley_adj[volley_index].pt_Y;
-
-            play_sample(*sfx[SFX_ZAP], 200, 0x40D8);
-
-            ++volley_index;
+        slot = pool_alloc(&bullet_pool);
+        bullet = &bullets[slot];
+
+        bullet->obj->world_x = player.obj->world_x;
+        bullet->obj->world_y = player.obj->world_y;
+        bullet->obj->world_z = player.obj->world_z;
+        bullet->corridor_index = player.corridor_index;
+        bullet->active = TRUE;
+        
+        bullet->obj->world_x += volley_adj[volley_index].pt_X;
+        bullet->obj->world_y += volley_adj[volley_index].pt_Y;
 
-            if (volley_index >= MAX_BULLETS)
-                volley_index = 0;
+        play_sample(*sfx[SFX_ZAP], 200, 0x40D8);
 
-            break;
-        }
+        ++volley_index;
 
-        ++bullet;
+        if (volley_index >= MAX_BULLETS)
+            volley_index = 0;
     }
 
     reset_simple_timer(&bullet_rate_timer, time_io);
@@ -1164,208 +1235,110 @@ void use_zapper(void)
 void add_bullets(void)
 {
     uint32 i;
-    bullet_typ_ptr bullet_it;
 
-    bullet_it = bullets;
-    i = MAX_BULLETS;
-
-    while (i--)
-    {
-        if (bullet_it->active)
-            add_obj(bullet_it->obj, TRUE);
-
-        ++bullet_it;
-    }
+    for (i = 0; i < bullet_pool.active_count; i++)
+        add_obj(bullets[POOL_SLOT(&bullet_pool, i)].obj, TRUE);
 }
 
 void update_bullets(uint32 delta_time)
 {
-    uint32 i, j;
-    int32 delta_x;
-    int32 delta_y;
+    uint32 i;
     bullet_typ_ptr bullet_it;
-    spike_typ_ptr spike_it;
     spike_typ_ptr corridor_spike;
-    enemy_typ_ptr enemy_it;
     enemy_typ_ptr corridor_enemy;
 
-    bullet_it = bullets;
-    i = MAX_BULLETS;
+    // Enemies moved since the index was last ordered
+    sort_corridor_enemies();
+
+    // From the end, spent bullets are released as we go
+    i = bullet_pool.active_count;
 
     while (i--)
     {
-        if (bullet_it->active)
-        {
-            // Check for spike on bullet's corridor
-            if (player.active)
-            {
-                spike_it = spikes;
-                j = MAX_SPIKES;
-                corridor_spike = NULL;
-                
-                while (j--)
-                {
-                    if (spike_it->active)
-                    {
-                        if (spike_it->corridor_index == bullet_it->corridor_index)
-                        {
-                            if (bullet_it->obj->world_z >= spike_it->end_pos[2])
-                                corridor_spike = spike_it;
+        bullet_it = &bullets[POOL_SLOT(&bullet_pool, i)];
 
-                            break;                                   
-                        }
-                    }
+        // Check for spike on bullet's corridor
+        if (player.active)
+        {
+            corridor_spike = get_corridor_spike(bullet_it->corridor_index);
 
-                    ++spike_it;
-                }
-                
-                // Check for enemy collision
+            if (corridor_spike && bullet_it->obj->world_z < corridor_spike->end_pos[2])
+                corridor_spike = NULL;
+            
+            // Check for enemy collision
+            corridor_enemy = get_bullet_enemy(bullet_it);
 
-                enemy_it = enemies;
-                j = MAX_ENEMIES;
-                corridor_enemy = NULL;
+            if (corridor_spike || corridor_enemy)
+            {
+                // Bullet hit either a spike or enemy
 
-                while (j--)
-                {                
-                    if (enemy_it->state == ES_ACTIVE)
+                if (corridor_spike && corridor_enemy)
+                {
+                    // Find out which one is closer
+                    if (corridor_enemy->obj->world_z <= corridor_spike->end_pos[2])
                     {
-                        if ((enemy_it->enemy_type == FLIPPER || enemy_it->enemy_type == FUSEBALL) 
-                            && enemy_it->obj->world_z == LEVEL_ZNEAR)
-                        {
-                            if (bullet_it->obj->world_z <= (LEVEL_ZNEAR + 32768)) 
-                            {
-                                // Bullet in Z range
-
-                                delta_x = ABS_VALUE(enemy_it->obj->world_x - bullet_it->obj->world_x);
-                                delta_y = ABS_VALUE(enemy_it->obj->world_y - bullet_it->obj->world_y);
-
-                                if (delta_x < 12000 && delta_y < 12000)
-                                {
-                                    // Hit
-                                    corridor_enemy = enemy_it;
-                                    break;
-                                }
-                            }
-                        }
-                        else 
-                        {
-                            // Be clever rather than run many 3D bounding sphere collision checks per bullet)
-                            
-                            // Don't bother checking collision unless enemy shares the bullet's corridor
-                            if (bullet_it->corridor_index == enemy_it->corridor_index)
-                            {
-                                // Check bullet/enemy Z extents
-                                if (bullet_it->obj->world_z >= enemy_it->obj->world_z - 16384 && 
-                                    bullet_it->obj->world_z <= enemy_it->obj->world_z + 16384)
-                                {                   
-                                    if (enemy_it->enemy_type == FUSEBALL)
-                                    {
-                                        // Only hit IF fuseball is not on corridor joint
-
-                                        vec3f16 p1;
-                                        int32 dist;
-                                        poly_props_typ props;
-                                        
-                                        props = get_corridor_props(&LCONTEXT_LEVEL.obj->polygons[enemy_it->corridor_index]);
-
-                                        p1[X] = enemy_it->obj->world_x;
-                                        p1[Y] = enemy_it->obj->world_y;
-                                        p1[Z] = props.near_edge[1][Z];
-
-                                        dist = get_squared_dist(p1, props.near_edge[1]);
-                                        
-                                        if (dist < 1000)
-                                        {
-                                            corridor_enemy = enemy_it;
-                                            break;
-                                        }
-                                    }
-                                    else 
-                                    {
-                                        // Simple case. Enemy hit.
-                                        corridor_enemy = enemy_it;
-                                        break;
-                                    }
-                                }
-                            }
-                        }
+                        // Enemy in front
+                        corridor_spike = NULL;
                     }
-
-                    ++enemy_it;
+                    else 
+                    {
+                        // Spike in front 
+                        corridor_enemy = NULL;
+                    } 
                 }
 
-                if (corridor_spike || corridor_enemy)
+                if (corridor_spike)
+                {
+                    // Spike hit
+                    damage_spike(corridor_spike);                    
+                }
+                else
                 {
-                    // Bullet hit either a spike or enemy
+                    // Enemy hit
+                    
+                    --corridor_enemy->health;
 
-                    if (corridor_spike && corridor_enemy)
+                    if (corridor_enemy->health <= 0)
                     {
-                        // Find out which one is closer
-                        if (corridor_enemy->obj->world_z <= corridor_spike->end_pos[2])
-                        {
-                            // Enemy in front
-                            corridor_spike = NULL;
-                        }
-                        else 
-                        {
-                            // Spike in front 
-                            corridor_enemy = NULL;
-                        } 
-                    }
+                        Point explosion_center;
+                        vec3f16 enemy_center;
+                        
+                        enemy_score(corridor_enemy);
+                        
+                        // Set enemy explosion
+                        enemy_center[X] = corridor_enemy->obj->world_x;
+                        enemy_center[Y] = corridor_enemy->obj->world_y;
+                        enemy_center[Z] = corridor_enemy->obj->world_z;
 
-                    if (corridor_spike)
-                    {
-                        // Spike hit
-                        damage_spike(corridor_spike);                    
-                    }
-                    else
-                    {
-                        // Enemy hit
+                        points_to_screen(&explosion_center, &enemy_center, 1, 0);
                         
-                        --corridor_enemy->health;
-
-                        if (corridor_enemy->health <= 0)
-                        {
-                            Point explosion_center;
-                            vec3f16 enemy_center;
-                            
-                            enemy_score(corridor_enemy);
-                            
-                            // Set enemy explosion
-                            enemy_center[X] = corridor_enemy->obj->world_x;
-                            enemy_center[Y] = corridor_enemy->obj->world_y;
-                            enemy_center[Z] = corridor_enemy->obj->world_z;
-
-                            point_to_camera(enemy_center, enemy_center);  
-                            point_to_screen(&explosion_center, enemy_center, TRUE);
-                            
-                            explode->ccb_HDX = 1258291;
-                            explode->ccb_VDY = 78643;
-                            explode->ccb_XPos = (explosion_center.pt_X - 8) << FRACBITS_16;
-                            explode->ccb_YPos = (explosion_center.pt_Y - 8) << FRACBITS_16;
-                            explode->ccb_Flags &= ~CCB_SKIP;
-
-                            // Remove enemy
-                            destroy_enemy(corridor_enemy, TRUE);                                                    
-                        }
+                        explode->ccb_HDX = 1258291;
+                        explode->ccb_VDY = 78643;
+                        explode->ccb_XPos = (explosion_center.pt_X - 8) << FRACBITS_16;
+                        explode->ccb_YPos = (explosion_center.pt_Y - 8) << FRACBITS_16;
+                        explode->ccb_Flags &= ~CCB_SKIP;
+
+                        // Remove enemy
+                        destroy_enemy(corridor_enemy, TRUE);                                                    
                     }
-
-                    bullet_it->active = FALSE;           
                 }
+
+                bullet_it->active = FALSE;           
             }
+        }
 
-            if (bullet_it->active)
-            {
-                // Bullet hasn't hit anything this frame
+        if (bullet_it->active)
+        {
+            // Bullet hasn't hit anything this frame
 
-                bullet_it->obj->world_z += MulSF16(BULLET_SPEED, delta_time);
+            bullet_it->obj->world_z += MulSF16(BULLET_SPEED, delta_time);
 
-                if (bullet_it->obj->world_z >= (LEVEL_ZFAR + 16384))
-                    bullet_it->active = FALSE;                
-            }
+            if (bullet_it->obj->world_z >= (LEVEL_ZFAR + 16384))
+                bullet_it->active = FALSE;                
         }
 
-        ++bullet_it;
+        if (!bullet_it->active)
+            pool_release(&bullet_pool, bullet_it - bullets);
     }
 }
 
@@ -1497,6 +1470,8 @@ void clear_bullets(void)
 
     for (i = 0; i < MAX_BULLETS; i++)
         bullets[i].active = FALSE;
+
+    pool_reset(&bullet_pool);
 }
 
 /* *************************************************************************************** */
@@ -1537,6 +1512,12 @@ void set_play_handler(uint32 index)
 
     reset_screen_colors(sc);
 
+    // The level spins into view during the intro, show every face while it does
+    if (index == PLAY_HANDLER_INTRO)
+        LCONTEXT_LEVEL.obj->flags &= ~OBJ_FLAG_BACKFACE_CULL;
+    else 
+        LCONTEXT_LEVEL.obj->flags |= OBJ_FLAG_BACKFACE_CULL;
+
     explode->ccb_Flags |= CCB_SKIP;
     watch_out->ccb_Flags |= CCB_SKIP;
 
@@ -1582,6 +1563,10 @@ void set_play_handler(uint32 index)
     {
         reset_skewable_cel(&gover_skewable);
         gover->ccb_Flags &= ~CCB_SKIP;
+
+        #if CAPTURE_FRAMES
+            capture_dump();
+        #endif
     }
     else if (index == PLAY_HANDLER_END)
     {
@@ -1591,14 +1576,19 @@ void set_play_handler(uint32 index)
         player.obj->world_z = 3 << FRACBITS_16;
         zero_camera();
         // Reset player rotation
-        copy_vertex_def(&player.obj->vertex_def, &player.obj->vertex_def_copy);
+        reset_obj_vertices(player.obj, &player.obj->vertex_def_copy);
+        reset_obj_rotation(player.obj);
         // Make it larger
         scale_obj(player.obj, 196608);
     }
 
     clear_score_cels();
 
+    // Game over only shows the overlay
+    dlist_show_layer(DLIST_LAYER_HUD, index != PLAY_HANDLER_OVER);
+
     play_handler_index = index;
+    guard_counts[index] = 0;
 }
 
 void play_start(void)
@@ -1613,6 +1603,10 @@ void play_start(void)
     init_stars();
     init_3d();
 
+    #if CAPTURE_FRAMES
+        capture_init();
+    #endif
+
     // Call reset_level_manager() before level cycling
     init_level_manager();	
 
@@ -1691,4 +1685,8 @@ int32 play_update(uint32 delta_time)
 void play_stop(void)
 {
     // Never reached since play state is at the root
+
+    #if CAPTURE_FRAMES
+        capture_free();
+    #endif
 }
@@ -136,8 +136,8 @@ void title_start(void)
     ccb = seek_cel_list(title_cel_list, CI_CREDIT);
     set_cel_position(ccb, 113, 210);
 
-    UNLAST_CEL(stars[MAX_STARS-1].ccb);
-    LINK_CEL(stars[MAX_STARS-1].ccb, seek_cel_list(title_cel_list, CI_LOGO));
+    UNLAST_CEL(stars.ccbs[MAX_STARS-1]);
+    LINK_CEL(stars.ccbs[MAX_STARS-1], seek_cel_list(title_cel_list, CI_LOGO));
 
     scale_obj(player.obj, 16384);
     set_obj_xyz(player.obj, -17000, 0, 1 << FRACBITS_16);
@@ -189,15 +189,14 @@ int32 title_update(uint32 delta_time)
         player.obj->world_x = -17000;
         #endif
 
-        /*  We need to reset the vertices once a full rotation has completed, otherwise, 
-            over time, precision errors will alter the vertices just enough to alter
+        /*  We need to reset the rotation once a full rotation has completed, otherwise, 
+            over time, precision errors will skew the matrix just enough to alter
             the model's appearance. */
 
         if (player_rot_amount >= 11796480)
         {
             // Reset player rotation
-            copy_vertex_def(&player.obj->vertex_def, &player.obj->vertex_def_copy);
-            scale_obj(player.obj, 16384);
+            reset_obj_rotation(player.obj);
             player_rot_amount = 0;
         }
 
@@ -218,7 +217,7 @@ int32 title_update(uint32 delta_time)
         add_obj(player.obj, TRUE);
         end_3d();
 
-        raster_scene_wireframe(cycle_colors[color_index], stars[0].ccb);
+        raster_scene_wireframe(cycle_colors[color_index], stars.ccbs[0]);
         
         if (++color_index >= MAX_COLOR_CYCLES)
             color_index = 0;
@@ -253,8 +252,7 @@ int32 title_update(uint32 delta_time)
                 {
                     run_gstate_loop(options_start, options_update, options_stop);    
                     // Reset player rotation
-                    copy_vertex_def(&player.obj->vertex_def, &player.obj->vertex_def_copy);
-                    scale_obj(player.obj, 16384);
+                    reset_obj_rotation(player.obj);
                     player_rot_amount = 0;
                 }
             }
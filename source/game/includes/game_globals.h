@@ -25,6 +25,11 @@
 #include "levels.h"
 #include "stimers.h"
 #include "maths.h"
+#include "trig.h"
+#include "dlist.h"
+#include "celcost.h"
+#include "capture.h"
+#include "pool.h"
 
 // Settings bit masks
 #define GAME_SETTINGS_CLEAR 0
@@ -33,19 +38,37 @@
 #define SET_GAME_SETTING(setting_mask) (game_settings |= setting_mask)
 #define UNSET_GAME_SETTING(setting_mask) (game_settings &= ~setting_mask)
 #define TOGGLE_GAME_SETTING(setting_mask) (game_settings ^= setting_mask)
+
+// Build profiles, pass -d PROFILE_STRESS to the compiler to raise entity capacities
+#ifdef PROFILE_STRESS
+#define MAX_BULLETS 32
+#define MAX_ENEMIES 64
+#define MAX_SPIKES 20           // One per corridor at most, see MAX_LEVEL_POLYS
+#define MAX_STARS 32
+#endif
+
 // General
 #define GOD_MODE 0
 #define SHOW_LEVEL_NORMALS 0    // Only use this for debugging / testing
 #define LEVEL_ZNEAR -262144
 #define LEVEL_ZFAR 262144
+#ifndef MAX_BULLETS
 #define MAX_BULLETS 5           // Max on screen at a time
+#endif
 #define BULLET_SPEED 851968
+#ifndef MAX_ENEMIES
 #define MAX_ENEMIES 6           // Max at a time
+#endif
+#define CORRIDOR_NONE 0xFFFFFFFF
 #define CAM_BASE_Z_OFFSET (LEVEL_ZNEAR - 163840)
 #define CAM_NEAR 32768
 #define PALETTE_SIZE_BYTES 64
+#ifndef MAX_SPIKES
 #define MAX_SPIKES 5
+#endif
+#ifndef MAX_STARS
 #define MAX_STARS 10
+#endif
 #define LEVEL_SKIP 0            // Only use this for debugging / testing
 // Player 
 #define MAX_LIVES 5
@@ -131,11 +154,6 @@ typedef struct spike_typ
     vec3f16 end_pos;
 } spike_typ, *spike_typ_ptr;
 
-typedef struct poly_props_typ 
-{
-    vec3f16 near_edge[3]; // A, Median, B
-} poly_props_typ, *poly_props_typ_ptr;
-
 typedef struct enemy_typ 
 {
     // Boolean active;
@@ -160,6 +178,9 @@ typedef struct enemy_typ
     int32 ticks;
 } enemy_typ, *enemy_typ_ptr;
 
+// Flippers and fuseballs on the near rim can be hit from any corridor
+#define IS_RIM_ENEMY(e) (((e)->enemy_type == FLIPPER || (e)->enemy_type == FUSEBALL) && (e)->obj->world_z == LEVEL_ZNEAR)
+
 typedef struct player_typ 
 {
     object_typ_ptr obj;
@@ -180,13 +201,13 @@ typedef struct bullet_typ
     object_typ_ptr obj;
 } bullet_typ, *bullet_typ_ptr;
 
-typedef struct star_typ 
+// Parallel arrays so positions can be projected in one batch
+typedef struct starfield_typ 
 {
-    CCB *ccb;
-    vec3f16 cam;
-    vec3f16 world;
-    vec3f16 reset_world;
-} star_typ;
+    CCB *ccbs[MAX_STARS];
+    vec3f16 world[MAX_STARS];
+    Point screen[MAX_STARS];
+} starfield_typ;
 
 #if DEBUG_MODE
     extern MemInfo vram_info;
@@ -196,21 +217,34 @@ typedef struct star_typ
 // gs_play.c
 extern void set_play_handler(uint32 index);
 extern Item *sfx[SFX_MAX];
-extern star_typ stars[MAX_STARS];
+extern starfield_typ stars;
 extern void init_stars(void);
 extern void update_stars(void);
-extern void reset_star(star_typ *sptr);
+extern void reset_star(uint32 index);
 extern void showcase_ship(void);
 extern uint32 game_settings;
 
 // corridors.c
-extern poly_props_typ get_corridor_props(polygon_typ_ptr corridor);
-extern int32 get_corridor_angle(polygon_typ_ptr corridor);
-extern void snap_obj_to_corridor(object_typ_ptr obj, polygon_typ_ptr corridor, int32 z);
+extern void init_corridors(level_typ_ptr level);
+extern corridor_typ_ptr get_corridor(uint32 corridor_index);
+extern void snap_obj_to_corridor(object_typ_ptr obj, uint32 corridor_index, int32 z);
 extern void reset_corridor(uint32 corridor_index);
 extern void reset_corridors(void);
 extern void reset_corridor_palette(uint32 corridor_index);
 extern void set_corridor_color(uint32 corridor_index, uint16 color);
+extern void clear_corridor_enemies(void);
+extern void clear_corridor_spikes(void);
+extern void index_enemy(enemy_typ_ptr enemy);
+extern void unindex_enemy(enemy_typ_ptr enemy);
+extern void index_spike(spike_typ_ptr spike);
+extern void unindex_spike(spike_typ_ptr spike);
+extern void sort_corridor_enemies(void);
+extern enemy_typ_ptr get_corridor_enemy(uint32 corridor_index);
+extern enemy_typ_ptr get_next_corridor_enemy(enemy_typ_ptr enemy);
+extern spike_typ_ptr get_corridor_spike(uint32 corridor_index);
+extern uint32 get_rim_enemies(enemy_typ_ptr **rim);
+extern enemy_typ_ptr get_bullet_enemy(bullet_typ_ptr bullet); // Enemy the bullet hits or NULL, call sort_corridor_enemies first
+extern uint32 get_free_corridor(void); // Random corridor without an enemy or spike, or CORRIDOR_NONE
 
 // enemies.c
 extern simple_timer_typ enemy_spawn_timer;
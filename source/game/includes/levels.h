@@ -13,11 +13,22 @@
 // Only works up to level 20
 #define STARTING_LEVEL 1
 
+typedef struct corridor_typ 
+{
+    vec3f16 near_edge[3];   // A, Median, B
+    int32 angle;            // Near edge angle
+    frac16 sin_angle;
+    frac16 cos_angle;
+    int32 left;             // Neighbour corridor indices, -1 past the ends of open levels
+    int32 right;
+} corridor_typ, *corridor_typ_ptr;
+
 typedef struct level_typ 
 {
     uint32 number;
     object_typ_ptr obj;
     uint16 palettes[MAX_LEVEL_POLYS][32];
+    corridor_typ corridors[MAX_LEVEL_POLYS]; // Built once per level by init_level
     uint32 wireframe_color;
     Boolean wrap;
 } level_typ, *level_typ_ptr;
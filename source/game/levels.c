@@ -54,6 +54,9 @@ static void init_level(uint32 level_index)
         FastMapCelInit(level->obj->polygons[i].ccb);
     }   
 
+    // Corridor edges and angles never change during play
+    init_corridors(level);
+
     // Color palette logic here
     apply_even_odd_pal(level);
 }
@@ -67,6 +70,8 @@ static void load_level(uint32 slot)
     sprintf(file_path, "Assets/Levels/Level%d", level_counter);
 
     level->obj = load_obj(file_path);
+    level->obj->priority = OBJ_PRIORITY_LEVEL;
+    level->obj->flags |= OBJ_FLAG_GUARD_CLIP;
     level->wrap = FALSE;
     level->obj->world_x = 0;
     level->obj->world_y = 0;
@@ -230,5 +235,6 @@ void reset_level_transrot(void)
     angles[1] = -4194304;
     angles[2] = 0;
     
+    reset_obj_rotation(LCONTEXT_LEVEL.obj);
     rotate_obj(LCONTEXT_LEVEL.obj, angles);
 }
\ No newline at end of file
@@ -14,6 +14,7 @@ void init_player(void)
     rez_envelope_typ rez_envelope;
 
     player.obj = load_obj("Assets/Entities/Player");
+    player.obj->priority = OBJ_PRIORITY_PLAYER;
 
     // Player will have 4 polygons
 
@@ -82,18 +83,15 @@ void reset_player(void)
 
 void snap_player(uint32 axis_flags)
 {
-    poly_props_typ props;
-    polygon_typ_ptr poly;
-    vec3f16 angles;
+    corridor_typ_ptr corridor;
 
-    poly = &LCONTEXT_LEVEL.obj->polygons[player.corridor_index];
-    props = get_corridor_props(poly);
+    corridor = get_corridor(player.corridor_index);
 
     // Snap
 
     if (axis_flags & X_AXIS)
     {
-        player.obj->world_x = props.near_edge[1][VERTEX_X];
+        player.obj->world_x = corridor->near_edge[1][VERTEX_X];
         set_cam_target_x(player.obj->world_x);       
     }
 
@@ -101,34 +99,29 @@ void snap_player(uint32 axis_flags)
 
     if (axis_flags & Y_AXIS)
     {
-        player.obj->world_y = props.near_edge[1][VERTEX_Y];
+        player.obj->world_y = corridor->near_edge[1][VERTEX_Y];
         set_cam_target_y(player.obj->world_y);
     }
 
     if (axis_flags & Z_AXIS)
         player.obj->world_z = LEVEL_ZNEAR;
      
-    // Reset player rotation
-    copy_vertex_def(&player.obj->vertex_def, player.active_vdef);
-
-    // Set rotation
-    angles[2] = get_corridor_angle(poly);
+    // Reset player shape
+    reset_obj_vertices(player.obj, player.active_vdef);
 
-    if (angles[2] != 0)
-    {
-        angles[0] = 0;
-        angles[1] = 0;
-        angles[2] = -angles[2];
-        rotate_obj(player.obj, angles);
-    }
+    // Set rotation, opposite of the corridor angle
+    if (corridor->angle != 0)
+        set_obj_rotation_z(player.obj, -corridor->sin_angle, corridor->cos_angle);
+    else 
+        reset_obj_rotation(player.obj);
 
-    player.rotation_angle = angles[2];
+    player.rotation_angle = -corridor->angle;
 }
 
 void trans_vertex_xy_by(vec3f16 vertex, int32 amount, int32 angle)
 {
-    int32 step_x = MulSF16(amount, CosF16(angle));
-    int32 step_y = MulSF16(amount, SinF16(angle)); 
+    int32 step_x = MulSF16(amount, cos_f16(angle));
+    int32 step_y = MulSF16(amount, sin_f16(angle)); 
 
     vertex[0] += step_x;
     vertex[1] += step_y;   
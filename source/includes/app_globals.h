@@ -9,6 +9,10 @@
 
 #define DEBUG_MODE 0            // Set this to zero for production builds
 #define SHOW_FPS 0
+#define SHOW_RENDER_STATS 0   // Draw per-frame 3D counters, debugging only
+#define SHOW_CEL_COST 0       // Print CEL engine cost and overdraw, debugging only
+#define CAPTURE_FRAMES 0      // Keep the costliest frame and print it at game over, debugging only
+#define DUMP_FOLIO_REFERENCE 0 // Print math folio results for the host checks at boot, debugging only
 #define FRACBITS_16 16          // For 16.16 fixed point shifting
 #define FRACBITS_20 20          // For 12.20 fixed point shifting
 #define ONE_F16 65536           // 2^16
@@ -0,0 +1,160 @@
+/**
+ * @file capture.h
+ * @brief Frame capture and replay of the CEL display list.
+ *
+ * A capture is one frame's visible display list layers, flattened into a single
+ * block: a header, one record per CCB, a chunk table, then the source data and
+ * PLUTs the CCBs point to. Pointers become indexes and offsets, and data shared
+ * by several CCBs is stored once.
+ *
+ * The console keeps the costliest frame seen since capture_init and prints it
+ * to the debug console with capture_dump. tools/capture_extract.py turns that
+ * log back into a binary file, which capture_replay draws on a host build with
+ * softcel and measures with celcost.
+ *
+ * Words are stored in the byte order of the machine that made the capture and
+ * capture_load swaps them when needed. Source pixels are left as bytes, which
+ * is all softcel reads.
+ */
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+// My includes
+#include "app_globals.h"
+#include "celcost.h"
+
+// 3DO includes
+#include "types.h"
+#include "graphics.h"
+
+#define CAPTURE_MAGIC 0x43415046    // CAPF
+#define CAPTURE_VERSION 1
+#define CAPTURE_NONE 0xFFFFFFFF     // Null index or offset
+
+#ifndef CAPTURE_BUFFER_SIZE
+#define CAPTURE_BUFFER_SIZE 131072
+#endif
+
+#define CAPTURE_MAX_CCBS 512
+#define CAPTURE_MAX_CHUNKS 128
+
+#define CAPTURE_CHUNK_SOURCE 0
+#define CAPTURE_CHUNK_PLUT 1
+
+typedef struct capture_header_typ
+{
+    uint32 magic;
+    uint32 version;
+    uint32 frame;           // Caller's frame number
+    uint32 cost;            // Caller's cost, captures are kept when it is higher
+    uint32 ccb_count;
+    uint32 chunk_count;
+    uint32 data_size;       // Bytes after the chunk table
+} capture_header_typ, *capture_header_typ_ptr;
+
+// A CCB with its pointers replaced
+typedef struct capture_ccb_typ
+{
+    uint32 layer;           // DLIST_LAYER_* it was drawn in
+    uint32 next;            // Record index, or CAPTURE_NONE
+    uint32 source;          // Data offset, or CAPTURE_NONE
+    uint32 plut;            // Data offset, or CAPTURE_NONE
+    uint32 flags;
+    int32 x_pos;
+    int32 y_pos;
+    int32 hdx;
+    int32 hdy;
+    int32 vdx;
+    int32 vdy;
+    int32 hddx;
+    int32 hddy;
+    uint32 pixc;
+    uint32 pre0;
+    uint32 pre1;
+    int32 width;
+    int32 height;
+} capture_ccb_typ, *capture_ccb_typ_ptr;
+
+typedef struct capture_chunk_typ
+{
+    uint32 offset;          // From the start of the data
+    uint32 size;
+    uint32 kind;            // CAPTURE_CHUNK_*
+} capture_chunk_typ, *capture_chunk_typ_ptr;
+
+/**
+ * @brief Allocate the capture buffer.
+ *
+ * @return Boolean FALSE if there was no memory
+ */
+Boolean capture_init(void);
+
+void capture_free(void);
+
+/**
+ * @brief Capture the visible display list layers if cost beats the kept frame.
+ *
+ * Call after the list is built for the frame. A frame that does not fit the
+ * buffer is dropped and the kept frame is lost with it.
+ * @param frame
+ * @param cost Any measure where higher is worse, such as celcost pixels
+ * @return Boolean TRUE if this frame is now the kept frame
+ */
+Boolean capture_frame(uint32 frame, uint32 cost);
+
+/**
+ * @brief Print the kept frame as hex lines for tools/capture_extract.py.
+ */
+void capture_dump(void);
+
+/**
+ * @brief The kept frame, for replaying it in the same process without capture_dump.
+ *
+ * @param size Gets the byte count, 0 if no frame is kept
+ * @return void* NULL if no frame is kept
+ */
+void *capture_kept(uint32 *size);
+
+/**
+ * @brief Rebuild a CCB chain from a capture, in place.
+ *
+ * Files come from off the console, so every count, link, offset and size is
+ * checked against the data before it is used or swapped.
+ * @param data Whole capture, word aligned. Byte order is fixed up in place.
+ * @param size
+ * @param ccbs Storage for the rebuilt CCBs
+ * @param max_ccbs
+ * @param layers Optional, gets the layer of each CCB
+ * @return CCB* First CCB, NULL if the capture is invalid or does not fit
+ */
+CCB *capture_load(void *data, uint32 size, CCB *ccbs, uint32 max_ccbs, uint32 *layers);
+
+#ifdef SOFTCEL
+
+#include "softcel.h"
+
+/**
+ * @brief Read a capture file made by tools/capture_extract.py.
+ *
+ * @param file_path
+ * @param data
+ * @param max_size
+ * @return int32 Bytes read, -1 on error
+ */
+int32 capture_read(char *file_path, void *data, uint32 max_size);
+
+/**
+ * @brief Load a capture, draw it into the target and add it to a cost report.
+ *
+ * @param data
+ * @param size
+ * @param target
+ * @param report Optional
+ * @return int32 CCBs replayed, -1 if the capture is invalid
+ */
+int32 capture_replay(void *data, uint32 size, softcel_target_typ_ptr target, celcost_report_typ_ptr report);
+
+#endif // SOFTCEL
+
+#endif // CAPTURE_H
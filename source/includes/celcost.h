@@ -0,0 +1,70 @@
+/**
+ * @file celcost.h
+ * @brief Estimates CEL engine cost for a display list.
+ * 
+ * Works from CCB fields alone, nothing is drawn. Each cel's outline is built from
+ * its position, HDX / HDY / VDX / VDY / HDDX / HDDY and size, then clipped to the
+ * screen. Screen pixels are the clipped outline's area, source pixels are the
+ * cel's width * height. The heatmap counts cels per tile using each clipped
+ * outline's bounding box.
+ */
+
+#ifndef CELCOST_H
+#define CELCOST_H
+
+// My includes
+#include "app_globals.h"
+
+// 3DO includes
+#include "types.h"
+#include "graphics.h"
+
+#define CELCOST_SCREEN_W 320
+#define CELCOST_SCREEN_H 240
+#define CELCOST_TILE_SHIFT 3    // 8x8 pixel heatmap tiles
+#define CELCOST_TILES_X (CELCOST_SCREEN_W >> CELCOST_TILE_SHIFT)
+#define CELCOST_TILES_Y (CELCOST_SCREEN_H >> CELCOST_TILE_SHIFT)
+#define CELCOST_MAX_GROUPS 4    // One per display list layer
+
+typedef struct celcost_group_typ
+{
+    uint32 cels;            // Cels the engine processed
+    uint32 skipped;         // CCB_SKIP set
+    uint32 offscreen;       // Processed but entirely outside the screen
+    uint32 plut_loads;      // CCB_LDPLUT set
+    uint32 source_pixels;   // Pixels fetched
+    uint32 screen_pixels;   // Pixels written, overlapping cels counted again
+} celcost_group_typ, *celcost_group_typ_ptr;
+
+typedef struct celcost_report_typ
+{
+    celcost_group_typ groups[CELCOST_MAX_GROUPS];
+    celcost_group_typ total;
+    CCB *worst_ccb;         // Cel with the most screen pixels
+    uint32 worst_pixels;
+    uint32 worst_group;
+    ubyte heatmap[CELCOST_TILES_Y][CELCOST_TILES_X]; // Cels touching each tile, saturates at 255
+} celcost_report_typ, *celcost_report_typ_ptr;
+
+void celcost_reset(celcost_report_typ_ptr report);
+
+/**
+ * @brief Add a linked chain of cels to the report.
+ * 
+ * Walks from first until last, a CCB_LAST cel or the end of the chain.
+ * @param report 
+ * @param group Index below CELCOST_MAX_GROUPS, usually a DLIST_LAYER_*
+ * @param first 
+ * @param last NULL to walk until CCB_LAST
+ */
+void celcost_add_chain(celcost_report_typ_ptr report, uint32 group, CCB *first, CCB *last);
+
+/**
+ * @brief Print the report and heatmap to the debug console.
+ * 
+ * @param report 
+ * @param label 
+ */
+void celcost_print(celcost_report_typ_ptr report, char *label);
+
+#endif // CELCOST_H
@@ -0,0 +1,81 @@
+/**
+ * @file dlist.h
+ * @brief Layered CEL display list.
+ * 
+ * Each layer is a chain of CCBs that stays linked across frames. Only the joins 
+ * between layers are rewritten when the list is drawn, so callers rebuild a layer
+ * only when its own contents change.
+ */
+
+#ifndef DLIST_H
+#define DLIST_H
+
+// My includes
+#include "app_globals.h"
+
+// 3DO includes
+#include "types.h"
+#include "graphics.h"
+
+// Layers are drawn in this order
+#define DLIST_LAYER_BG 0        // Backgrounds
+#define DLIST_LAYER_3D 1        // Sorted polygons, set by end_3d
+#define DLIST_LAYER_HUD 2       // In game HUD
+#define DLIST_LAYER_OVERLAY 3   // Messages, score and anything else on top
+#define DLIST_MAX_LAYERS 4
+
+typedef struct dlist_layer_typ
+{
+    CCB *first;
+    CCB *last;
+    Boolean hidden;
+} dlist_layer_typ, *dlist_layer_typ_ptr;
+
+/**
+ * @brief Empty every layer and show them all.
+ */
+void dlist_reset(void);
+
+/**
+ * @brief Replace a layer with a chain that is already linked from first to last.
+ * 
+ * @param layer DLIST_LAYER_*
+ * @param first NULL empties the layer
+ * @param last 
+ */
+void dlist_set_layer(uint32 layer, CCB *first, CCB *last);
+
+/**
+ * @brief Link a chain to the end of a layer.
+ * 
+ * @param layer DLIST_LAYER_*
+ * @param first 
+ * @param last Same as first for a single CCB
+ */
+void dlist_append(uint32 layer, CCB *first, CCB *last);
+
+void dlist_show_layer(uint32 layer, Boolean show);
+
+/**
+ * @brief Read access to a layer, for debugging tools.
+ * 
+ * @param layer DLIST_LAYER_*
+ * @return dlist_layer_typ_ptr 
+ */
+dlist_layer_typ_ptr dlist_get_layer(uint32 layer);
+
+/**
+ * @brief Join the visible layers and terminate the last one.
+ * 
+ * @return CCB* First CCB to draw, NULL if every visible layer is empty
+ */
+CCB *dlist_link(void);
+
+/**
+ * @brief Link and draw the list.
+ * 
+ * @param bitmap_item 
+ */
+void dlist_draw(Item bitmap_item);
+
+#endif // DLIST_H
@@ -0,0 +1,98 @@
+/**
+ * @file fixmath.h
+ * @brief 16.16 fixed point primitives used by the 3D library.
+ * 
+ * On the console the FIX_ macros map to the math folio. Building with
+ * FIXMATH_PORTABLE defined maps them to the plain C reference versions below
+ * and takes the base types from portable.h instead of the SDK, so threed.c and
+ * maths.c can be built and checked off the console. The reference versions
+ * need a 64 bit integer type and are only built with FIXMATH_PORTABLE.
+ * 
+ * Reference semantics:
+ *  - fix_mul_f16 floors (a * b) >> 16 of the 64 bit product. Results outside 32 bits wrap.
+ *  - fix_div_f16 truncates (a << 16) / b toward zero. Results outside 32 bits wrap.
+ *    Dividing by 0 saturates to the largest value with the sign of a, 0 counts as positive.
+ *  - fix_sqrt_f16 floors the square root. Negative input returns 0.
+ *  - Vector and matrix kernels round each product the same way as fix_mul_f16.
+ * 
+ * tools/host/fixmath_check.c compares these against results logged from the
+ * folio on a console, see folioref.h.
+ */
+
+#ifndef FIXMATH_H
+#define FIXMATH_H
+
+#ifdef FIXMATH_PORTABLE
+    #include "portable.h"
+#else
+    // 3DO includes
+    #include "types.h"
+    #include "graphics.h"
+    #include "operamath.h"
+#endif
+
+#ifdef FIXMATH_PORTABLE
+    #define FIX_MUL(a, b) fix_mul_f16(a, b)
+    #define FIX_DIV(a, b) fix_div_f16(a, b)
+    #define FIX_SQRT(a) fix_sqrt_f16(a)
+    #define FIX_SQUARE(a) fix_mul_f16(a, a)
+    #define FIX_DOT3(a, b) fix_dot3_f16(a, b)
+    #define FIX_CROSS3(dest, a, b) fix_cross3_f16(dest, a, b)
+    #define FIX_MUL_VEC3_MAT33(dest, vec, mat) fix_mul_vec3_mat33_f16(dest, vec, mat)
+    #define FIX_MUL_MANY_VEC3_MAT33(dest, src, mat, count) fix_mul_many_vec3_mat33_f16(dest, src, mat, count)
+    #define FIX_MUL_MAT33_MAT33(dest, a, b) fix_mul_mat33_mat33_f16(dest, a, b)
+#else
+    #define FIX_MUL(a, b) MulSF16(a, b)
+    #define FIX_DIV(a, b) DivSF16(a, b)
+    #define FIX_SQRT(a) SqrtF16(a)
+    #define FIX_SQUARE(a) SquareSF16(a)
+    #define FIX_DOT3(a, b) Dot3_F16(a, b)
+    #define FIX_CROSS3(dest, a, b) Cross3_F16(dest, a, b)
+    #define FIX_MUL_VEC3_MAT33(dest, vec, mat) MulVec3Mat33_F16(dest, vec, mat)
+    #define FIX_MUL_MANY_VEC3_MAT33(dest, src, mat, count) MulManyVec3Mat33_F16(dest, src, mat, count)
+    #define FIX_MUL_MAT33_MAT33(dest, a, b) MulMat33Mat33_F16(dest, a, b)
+#endif
+
+#ifdef FIXMATH_PORTABLE
+
+frac16 fix_mul_f16(frac16 a, frac16 b);
+
+frac16 fix_div_f16(frac16 a, frac16 b);
+
+frac16 fix_sqrt_f16(frac16 a);
+
+frac16 fix_dot3_f16(vec3f16 a, vec3f16 b);
+
+void fix_cross3_f16(vec3f16 dest, vec3f16 a, vec3f16 b);
+
+/**
+ * @brief dest = vec * mat. dest may equal vec.
+ */
+void fix_mul_vec3_mat33_f16(vec3f16 dest, vec3f16 vec, mat33f16 mat);
+
+void fix_mul_many_vec3_mat33_f16(vec3f16 *dest, vec3f16 *src, mat33f16 mat, int32 count);
+
+/**
+ * @brief dest = a * b. dest may equal a or b.
+ */
+void fix_mul_mat33_mat33_f16(mat33f16 dest, mat33f16 a, mat33f16 b);
+
+#endif // FIXMATH_PORTABLE
+
+/**
+ * @brief Perspective divide count camera space points into 16.16 screen points.
+ * 
+ * Each point maps to (x << view_shift) / z + center, with y flipped. z is
+ * clamped to near first, and a zero z is treated as 1.
+ * @param dest 
+ * @param src 
+ * @param count 
+ * @param view_shift 
+ * @param near 
+ * @param center_x 
+ * @param center_y 
+ */
+void fix_project_points_f16(Point *dest, vec3f16 *src, int32 count, int32 view_shift, int32 near, 
+    frac16 center_x, frac16 center_y);
+
+#endif // FIXMATH_H
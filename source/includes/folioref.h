@@ -0,0 +1,51 @@
+/**
+ * @file folioref.h
+ * @brief Reference results logged from the math folio.
+ * 
+ * The host checks in tools/host compare fixmath.c and trig.c against the folio.
+ * folioref_input gives both sides the same inputs. On a console build with
+ * DUMP_FOLIO_REFERENCE set, folioref_dump prints one line per input to the debug
+ * console, FREF kind index a b result with the values in hex. Save that output
+ * and pass it to build_host.sh.
+ */
+
+#ifndef FOLIOREF_H
+#define FOLIOREF_H
+
+#ifdef FIXMATH_PORTABLE
+    #include "portable.h"
+#else
+    // 3DO includes
+    #include "types.h"
+    #include "operamath.h"
+#endif
+
+#define FOLIOREF_MUL 0          // MulSF16(a, b)
+#define FOLIOREF_DIV 1          // DivSF16(a, b)
+#define FOLIOREF_SQRT 2         // SqrtF16(a)
+#define FOLIOREF_SIN 3          // SinF16(a)
+#define FOLIOREF_COS 4          // CosF16(a)
+#define FOLIOREF_ATAN2 5        // Atan2F16(a, b)
+#define FOLIOREF_KINDS 6
+#define FOLIOREF_COUNT 512      // Inputs per kind
+
+/**
+ * @brief Input pair for one reference call. Fixed edge cases come first, the rest are pseudo random.
+ * 
+ * @param kind FOLIOREF_ value.
+ * @param index 0 to FOLIOREF_COUNT - 1.
+ * @param a 
+ * @param b Unused by the single argument kinds, set to 0.
+ */
+void folioref_input(uint32 kind, uint32 index, frac16 *a, frac16 *b);
+
+#ifndef FIXMATH_PORTABLE
+
+/**
+ * @brief Print every reference call and its folio result. Needs the math folio open.
+ */
+void folioref_dump(void);
+
+#endif // FIXMATH_PORTABLE
+
+#endif // FOLIOREF_H
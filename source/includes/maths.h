@@ -1,7 +1,7 @@
 #ifndef MATHS_H
 #define MATHS_H
 
-#include "operamath.h"
+#include "fixmath.h"
 
 #define ABS_VALUE(x) ((x) >= 0 ? (x) : -(x))
 
@@ -0,0 +1,71 @@
+/**
+ * @file pool.h
+ * @brief Fixed capacity slot pools.
+ * 
+ * A pool hands out slots of an item array its owner keeps, with a free list so
+ * allocating and releasing are O(1) and a dense active list so updates only visit
+ * live slots. POOL_DEFINE sizes the storage at compile time.
+ * 
+ * Walk the active list from the end. Releasing a slot moves the last entry into
+ * its place, which has then already been visited, and slots allocated during the
+ * walk are appended where they will not be.
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+// My includes
+#include "app_globals.h"
+
+// 3DO includes
+#include "types.h"
+
+#define POOL_NONE 0xFFFF
+#define POOL_MAX_CAPACITY 0xFFFF
+
+typedef struct pool_typ
+{
+    uint16 *free_slots;     // Stack, next slot to hand out on top
+    uint16 *active;         // Active slots, in no particular order
+    uint16 *positions;      // Index of each slot in active, POOL_NONE when free
+    uint32 capacity;
+    uint32 free_count;
+    uint32 active_count;
+} pool_typ, *pool_typ_ptr;
+
+// Define a pool and its storage for an item array of the given capacity
+#define POOL_DEFINE(name, capacity) \
+    static uint16 name##_free_slots[capacity]; \
+    static uint16 name##_active[capacity]; \
+    static uint16 name##_positions[capacity]; \
+    static pool_typ name = {name##_free_slots, name##_active, name##_positions, capacity, 0, 0}
+
+// Slot of the i-th active entry
+#define POOL_SLOT(pool, i) ((pool)->active[i])
+
+#define POOL_IS_ACTIVE(pool, slot) ((pool)->positions[slot] != POOL_NONE)
+
+/**
+ * @brief Release every slot. Slots are then handed out lowest first.
+ * 
+ * @param pool 
+ */
+void pool_reset(pool_typ_ptr pool);
+
+/**
+ * @brief Take a free slot.
+ * 
+ * @param pool 
+ * @return uint32 Slot, or POOL_NONE when the pool is full
+ */
+uint32 pool_alloc(pool_typ_ptr pool);
+
+/**
+ * @brief Return an active slot to the free list.
+ * 
+ * @param pool 
+ * @param slot 
+ */
+void pool_release(pool_typ_ptr pool, uint32 slot);
+
+#endif // POOL_H
@@ -0,0 +1,47 @@
+/**
+ * @file portable.h
+ * @brief 3DO base types for builds off the console.
+ *
+ * Included in place of the SDK's types.h and operamath.h when FIXMATH_PORTABLE
+ * is defined. The layouts match the SDK, so the same code and data work on
+ * both sides. The host checks in tools/host build on top of this.
+ */
+
+#ifndef PORTABLE_H
+#define PORTABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef int8_t int8;
+typedef uint8_t uint8;
+typedef uint8_t ubyte;
+typedef int16_t int16;
+typedef uint16_t uint16;
+typedef int32_t int32;
+typedef uint32_t uint32;
+typedef int32 Item;
+typedef int32 Err;
+typedef int32 Boolean;
+typedef int32 Coord;
+
+typedef int32 frac16;
+typedef frac16 vec3f16[3];
+typedef frac16 vec4f16[4];
+typedef frac16 mat33f16[3][3];
+
+typedef struct Point
+{
+    Coord pt_X;
+    Coord pt_Y;
+} Point;
+
+#ifndef TRUE
+#define TRUE 1
+#endif
+
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+#endif // PORTABLE_H
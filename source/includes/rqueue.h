@@ -0,0 +1,80 @@
+/**
+ * @file rqueue.h
+ * @brief Per-frame render queue of polygons.
+ * 
+ * Storage is reused every frame and grows on demand up to RQUEUE_BUDGET entries.
+ * A polygon and the clip pieces it was split into are queued, kept and dropped
+ * together. Once the budget is reached, the newest polygons of the lowest
+ * priority are evicted first.
+ */
+
+#ifndef RQUEUE_H
+#define RQUEUE_H
+
+// My includes
+#include "threed.h"
+
+// 3DO includes
+#include "types.h"
+
+// Override these in the build for stress testing
+#ifndef RQUEUE_INITIAL
+#define RQUEUE_INITIAL 64       // Entries allocated on first use
+#endif
+
+#ifndef RQUEUE_BUDGET
+#define RQUEUE_BUDGET 256       // Entries the queue will never grow past
+#endif
+
+typedef struct rqueue_typ
+{
+    polygon_typ_ptr *items;     // Valid after rqueue_pack
+    polygon_typ_ptr *scratch;   // Same capacity as items, free for sorting
+    polygon_typ_ptr *groups;    // First polygon of each push, NULL once evicted
+    uint16 *group_sizes;        // Entries in each push, the polygon and its pieces
+    uint16 *group_links;        // Previous push of the same priority, or the next free record
+    uint16 tier_tops[OBJ_PRIORITIES];   // Newest push of each priority
+    uint32 tier_sizes[OBJ_PRIORITIES];  // Entries queued at each priority
+    uint32 group_count;         // Records in use, including freed ones
+    uint16 free_groups;
+    Boolean packed;             // items is up to date, FALSE after an eviction
+    uint32 size;
+    uint32 capacity;
+    uint32 high_water;          // Largest size reached since start up
+    uint32 dropped;             // Polygons rejected or evicted since the last reset
+} rqueue_typ, *rqueue_typ_ptr;
+
+/**
+ * @brief Empty the queue for a new frame. Storage is kept.
+ * 
+ * @param queue 
+ */
+void rqueue_reset(rqueue_typ_ptr queue);
+
+/**
+ * @brief Add a polygon and the clip pieces it was split into.
+ * 
+ * When the budget is full, the newest lower priority polygons are evicted until
+ * the whole group fits. If that is not possible, the group is dropped and
+ * nothing is evicted.
+ * @param queue 
+ * @param poly 
+ * @return Boolean TRUE if poly was queued
+ */
+Boolean rqueue_push(rqueue_typ_ptr queue, polygon_typ_ptr poly);
+
+/**
+ * @brief Bring items up to date after evictions. Call before reading items.
+ * 
+ * @param queue 
+ */
+void rqueue_pack(rqueue_typ_ptr queue);
+
+/**
+ * @brief Release queue storage.
+ * 
+ * @param queue 
+ */
+void rqueue_free(rqueue_typ_ptr queue);
+
+#endif // RQUEUE_H
@@ -0,0 +1,64 @@
+/**
+ * @file softcel.h
+ * @brief Software model of the CEL engine subset the game uses.
+ * 
+ * Only built when SOFTCEL is defined, which pairs with FIXMATH_PORTABLE for a
+ * host build. It walks a CCB chain the way DrawCels does and writes a linear
+ * RGB555 image, so captured frames can be rendered and compared off the console.
+ * 
+ * Supported:
+ *  - Coded 8bpp unpacked cels with a 32 entry PLUT, SKIPX and WOFFSET sub regions.
+ *  - Any corner mapping set through the CCB, including FastMapCelf16. Each cel is scan
+ *    converted once as a quad. Source positions are exact along its sides and stepped
+ *    linearly across each row, so HDDX / HDDY warps are approximated inside the quad.
+ *  - CCB_SKIP, CCB_LAST, CCB_LDPLUT, CCB_BGND, CCB_ACW and CCB_ACCW.
+ *  - The PIXC fields the game uses: multiply, divide, and adding the frame buffer or a constant.
+ * 
+ * Super clipping only saves CEL engine time, here every cel is clipped to the target.
+ * Anything else, such as packed or uncoded cels, is counted and skipped.
+ */
+
+#ifndef SOFTCEL_H
+#define SOFTCEL_H
+
+// 3DO includes
+#include "types.h"
+#include "graphics.h"
+
+typedef struct softcel_target_typ
+{
+    uint16 *pixels;             // RGB555, width * height, rows top to bottom
+    int32 width;
+    int32 height;
+    uint32 cels_drawn;          // Counters since the last softcel_clear
+    uint32 cels_skipped;        // CCB_SKIP set
+    uint32 cels_unsupported;
+    uint32 pixels_written;
+} softcel_target_typ, *softcel_target_typ_ptr;
+
+/**
+ * @brief Fill the target with color and zero its counters.
+ * 
+ * @param target 
+ * @param color RGB555
+ */
+void softcel_clear(softcel_target_typ_ptr target, uint16 color);
+
+/**
+ * @brief Draw a CCB chain into the target, the same as DrawCels would.
+ * 
+ * @param target 
+ * @param ccb First CCB in the chain
+ */
+void softcel_draw(softcel_target_typ_ptr target, CCB *ccb);
+
+/**
+ * @brief Write the target as a binary PPM.
+ * 
+ * @param target 
+ * @param file_path 
+ * @return int32 0 on success, -1 if the file could not be written
+ */
+int32 softcel_write_ppm(softcel_target_typ_ptr target, char *file_path);
+
+#endif // SOFTCEL_H
@@ -33,6 +33,28 @@
 #define ANGLE_Y 1
 #define ANGLE_Z 2
 
+// Object flags
+#define OBJ_FLAG_BACKFACE_CULL 1    // Skip polygons facing away from the camera
+#define OBJ_FLAG_GUARD_CLIP 2       // Cels are a single color, cut outlines to the guard band instead of passing them through
+
+// Object priorities, lower priority polygons are dropped first when the render queue is full
+#define OBJ_PRIORITY_LEVEL 0
+#define OBJ_PRIORITY_ENEMY 1
+#define OBJ_PRIORITY_PLAYER 2
+#define OBJ_PRIORITIES 3
+
+// Guard band modes, see set_guard_band
+#define GUARD_BAND_OFF 0        // Projected corners go to the CEL engine as is
+#define GUARD_BAND_REJECT 1     // Polygons reaching past the band are not drawn
+#define GUARD_BAND_CLIP 2       // OBJ_FLAG_GUARD_CLIP polygons are cut to the band, others are drawn whole if they overlap it
+
+#ifndef GUARD_BAND_MARGIN
+#define GUARD_BAND_MARGIN 64    // Pixels past each screen edge
+#endif
+
+// Call after writing to an object's vertices directly so add_obj rebuilds its screen vertices
+#define MARK_OBJ_DIRTY(obj) ((obj)->version++)
+
 typedef struct vertex_typ
 {
     vec3f16 vertex;    
@@ -44,6 +66,16 @@ typedef struct vertex_def_typ
     vertex_typ_ptr vertices;
 } vertex_def_typ, *vertex_def_typ_ptr;
 
+// Edge shared by one or more polygons of an object, see raster_scene_wireframe
+typedef struct edge_typ
+{
+    uint16 a;               // vertex_def indices, a < b
+    uint16 b;
+    uint32 stamp;           // Wireframe frame the edge was last drawn in
+} edge_typ, *edge_typ_ptr;
+
+#define EDGE_NONE 0xFFFF    // Polygon side with both corners on the same vertex
+
 struct object_typ;
 
 typedef struct polygon_typ
@@ -56,6 +88,13 @@ typedef struct polygon_typ
     Point screen[4];
     vec3f16 normal;
     int32 avgz;
+    uint32 sort_rank;       // Position in last sorted frame
+    uint32 sort_stamp;      // Sort frame that sort_rank belongs to
+    Boolean cache_queued;   // Passed the near and back face tests when the object cache was built
+    struct polygon_typ *clip_piece; // Next piece when clipping leaves more than 4 corners, allocated on first use
+    Boolean clip_split;     // clip_piece is queued along with this polygon
+    Boolean screen_clipped; // Corners were cut, screen no longer matches the object's screen vertices
+    uint16 edge_lut[4];     // Side i runs from vertex_lut[i] to vertex_lut[i+1], index into the parent's edges
     uint16 pal_backup[32];
 } polygon_typ, *polygon_typ_ptr;
 
@@ -68,7 +107,30 @@ typedef struct object_typ
     vertex_def_typ vertex_def_copy;
     uint32 poly_count;
     polygon_typ_ptr polygons;
-    uint32 bsphere_radius;
+    uint32 bsphere_radius;  // Collision radius, set by the game
+    uint32 cull_radius;     // Frustum test radius, measured when shape_version changes
+    uint32 cull_version;    // shape_version cull_radius was measured at
+    uint32 shape_version;   // Bumped by scale_obj* and reset_obj_vertices, rotation leaves it alone
+    vec3f16 *camera_verts;  // Camera space vertices, one per vertex_def entry
+    Point *screen_verts;    // 16.16 screen space vertices, one per vertex_def entry
+    uint32 version;         // Bumped whenever vertex_def changes, see MARK_OBJ_DIRTY
+    uint32 cache_version;   // Inputs screen_verts were built from
+    uint32 cache_cam_version;
+    int32 cache_world_x;
+    int32 cache_world_y;
+    int32 cache_world_z;
+    int32 cache_mode;
+    int32 cache_near;
+    uint32 cache_flags;
+    uint32 cache_backfaced; // Polygons rejected as back faces when the cache was built
+    uint32 flags;           // OBJ_FLAG_*
+    uint32 normals_version; // Version polygon normals were calculated for
+    uint32 priority;        // OBJ_PRIORITY_*
+    mat33f16 rotation;      // Applied to vertex_def during projection
+    Boolean rotated;        // FALSE while rotation is the identity
+    uint32 rotation_steps;  // Compositions since rotation was last orthonormalized
+    edge_typ_ptr edges;     // Unique polygon sides, built at load, see build_obj_edges
+    uint32 edge_count;
 } object_typ, *object_typ_ptr;
 
 typedef struct camera_typ 
@@ -76,12 +138,44 @@ typedef struct camera_typ
     int32 world_x;
     int32 world_y;
     int32 world_z;
+    uint32 version;         // Bumped by the 3D library when the camera moves
 } camera_typ, *camera_typ_ptr;
 
+typedef struct render_stats_typ
+{
+    uint32 polys_reused;        // Polygons queued with last frame's screen corners
+    uint32 polys_recomputed;    // Polygons queued after reprojection
+    uint32 objs_culled;         // Objects rejected by the bounding sphere test
+    uint32 objs_drawn;          // Objects that passed the bounding sphere test
+    uint32 polys_backfaced;     // Polygons rejected by OBJ_FLAG_BACKFACE_CULL
+    uint32 polys_clipped;       // Polygons cut by the near plane in add_obj_zclip
+    uint32 polys_guard_clipped; // Polygons cut to the guard band, or drawn unclipped past it
+    uint32 polys_guard_rejected; // Polygons dropped by the guard band
+    uint32 links_rewritten;     // 3D layer CCB links changed by end_3d
+    uint32 polys_dropped;       // Polygons that did not fit the render queue, set by end_3d
+    uint32 queue_high_water;    // Largest render queue since start up, set by end_3d
+} render_stats_typ, *render_stats_typ_ptr;
+
 extern camera_typ camera;
 
+// Reset by begin_3d
+extern render_stats_typ render_stats;
+
 void init_3d(void);
 
+/**
+ * @brief Configure the guard band applied before polygons are mapped to CCBs.
+ * 
+ * The band is the screen grown by margin pixels on every side. init_3d sets
+ * GUARD_BAND_CLIP with GUARD_BAND_MARGIN. Clipping squeezes the whole cel into
+ * the cut outline, so only objects with OBJ_FLAG_GUARD_CLIP are cut. Textured
+ * polygons reaching past the band are drawn unclipped, or rejected when they
+ * miss the band entirely.
+ * @param mode GUARD_BAND_*
+ * @param margin 
+ */
+void set_guard_band(uint32 mode, int32 margin);
+
 object_typ_ptr copy_obj(object_typ_ptr source);
 
 void poly_to_world_cam(polygon_typ_ptr poly);
@@ -94,6 +188,17 @@ void poly_to_screen(polygon_typ_ptr poly, Boolean use_inv_lut);
 
 void point_to_screen(Point *dest, vec3f16 point, Boolean use_inv_lut);
 
+/**
+ * @brief Project count world points to integer screen points in one pass.
+ * 
+ * Always uses the inverse depth table. Camera z is clamped to near, which must be 0 or more.
+ * @param dest 
+ * @param points World positions.
+ * @param count 
+ * @param near 
+ */
+void points_to_screen(Point *dest, vec3f16 *points, int32 count, int32 near);
+
 void calc_poly_normal(polygon_typ_ptr poly);
 
 void scale_obj(object_typ_ptr obj, int32 scale_factor);
@@ -105,6 +210,7 @@ void scale_obj_y(object_typ_ptr obj, int32 scale_factor);
 /**
  * @brief Rotate object on specified axis via angles.
  * 
+ * The rotation is composed with the object's matrix, vertices are not modified.
  * @param obj 
  * @param angles 
  */
@@ -115,12 +221,44 @@ void rotate_obj4_z(object_typ_ptr obj, int32 angle);
 /**
  * @brief Rotate object around pivot point along z axis.
  * 
+ * Moves the object's center and composes the rotation with its matrix.
  * @param obj 
  * @param pivot 
  * @param angle 
  */
 void rotate_obj_pivot_z(object_typ_ptr obj, vec3f16 pivot, int32 angle);
 
+/**
+ * @brief Set the object's rotation back to the identity.
+ * 
+ * @param obj 
+ */
+void reset_obj_rotation(object_typ_ptr obj);
+
+/**
+ * @brief Replace the object's rotation with a z rotation from a precomputed sine and cosine.
+ * 
+ * @param obj 
+ * @param sn 
+ * @param cs 
+ */
+void set_obj_rotation_z(object_typ_ptr obj, frac16 sn, frac16 cs);
+
+/**
+ * @brief Rotate an object space vector by the object's rotation. dest may equal source.
+ * 
+ * @param obj 
+ * @param dest 
+ * @param source 
+ */
+void rotate_obj_vector(object_typ_ptr obj, vec3f16 dest, vec3f16 source);
+
+/**
+ * @brief Sort added polygons back to front by average camera z.
+ * 
+ * A bucket pass on avgz is used, or last frame's order when the same polygons
+ * were added again. An insertion pass then settles the final order.
+ */
 void sort_polys(void);
 
 uint32 calc_bsphere_radius(object_typ_ptr obj);
@@ -133,6 +271,14 @@ uint32 calc_bsphere_radius(object_typ_ptr obj);
  */
 void copy_vertex_def(vertex_def_typ_ptr dest, vertex_def_typ_ptr source);
 
+/**
+ * @brief Copy source into the object's vertices and mark it dirty.
+ * 
+ * @param obj 
+ * @param source 
+ */
+void reset_obj_vertices(object_typ_ptr obj, vertex_def_typ_ptr source);
+
 /**
  * @brief Allocate space in dest and copy source into dest.
  * 
@@ -164,11 +310,25 @@ object_typ_ptr load_obj(char *path);
 
 void unload_obj(object_typ_ptr obj);
 
+/**
+ * @brief Transform and project obj, then add its polygons to the raster list.
+ * 
+ * Each shared vertex is transformed once into the object's camera and screen buffers.
+ * Polygons gather their corners from those buffers. If neither the object
+ * nor the camera changed since the last call, last frame's corners are reused.
+ * Objects whose bounding sphere is outside the view are skipped. With
+ * OBJ_FLAG_BACKFACE_CULL set, polygons facing away from the camera are skipped.
+ * When the render queue is full, polygons are dropped by object priority.
+ * @param obj 
+ * @param use_inv_lut 
+ * @return int32 
+ */
 int32 add_obj(object_typ_ptr obj, Boolean use_inv_lut);
 
 /**
  * @brief 
  * This will only work for axis-aligned quads.
+ * Objects whose bounding sphere is behind near or outside the view are skipped.
  * @param poly 
  * @param near 
  * @return Boolean 
@@ -185,8 +345,18 @@ void begin_3d(void);
  */
 void end_3d(void);
 
-void raster_scene(CCB *bg_start, CCB *bg_end, CCB *fg_start);
+/**
+ * @brief Draw the display list, see dlist.h. end_3d fills DLIST_LAYER_3D.
+ */
+void raster_scene(void);
 
+/**
+ * @brief Draw queued polygons as lines, then the fg chain if given.
+ * 
+ * Sides shared by neighbouring polygons of the same object are drawn once.
+ * @param color 
+ * @param fg 
+ */
 void raster_scene_wireframe(uint32 color, CCB *fg);
 
 void print_obj(object_typ_ptr obj);
@@ -205,6 +375,20 @@ void draw_poly_wireframe(polygon_typ_ptr poly, uint32 color);
 
 void set_obj_xyz(object_typ_ptr obj, int32 x, int32 y, int32 z);
 
+/**
+ * @brief Calculate all polygon normals. Back face culling calls this when the object changed.
+ * 
+ * @param obj 
+ */
 void calc_obj_normals(object_typ_ptr obj);
 
+/**
+ * @brief Collect the unique polygon sides raster_scene_wireframe draws. load_obj calls this.
+ * 
+ * Polygons list their own four sides, so neighbours repeat every shared side.
+ * Cost is quadratic in edges, so call it at load time only.
+ * @param obj 
+ */
+void build_obj_edges(object_typ_ptr obj);
+
 #endif // THREED_H
\ No newline at end of file
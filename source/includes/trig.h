@@ -0,0 +1,40 @@
+/**
+ * @file trig.h
+ * @brief Table driven sine, cosine and arctangent.
+ * 
+ * Drop in replacements for SinF16, CosF16 and Atan2F16. Angles use the same
+ * 16.16 units, 256.0 is a full turn. Tables are generated by tools/gen_trig_lut.py,
+ * which also reports accuracy against exact results. tools/host/trig_check.c
+ * compares them against results logged from the folio, see folioref.h.
+ */
+
+#ifndef TRIG_H
+#define TRIG_H
+
+// 3DO includes
+#include "types.h"
+#include "operamath.h"
+
+frac16 sin_f16(frac16 angle);
+
+frac16 cos_f16(frac16 angle);
+
+/**
+ * @brief Sine and cosine of one angle.
+ * 
+ * @param angle 
+ * @param sn 
+ * @param cs 
+ */
+void sincos_f16(frac16 angle, frac16 *sn, frac16 *cs);
+
+/**
+ * @brief Angle of the vector (x, y) in the range 0 - 256.0, argument order matches Atan2F16.
+ * 
+ * @param x 
+ * @param y 
+ * @return frac16 
+ */
+frac16 atan2_f16(frac16 x, frac16 y);
+
+#endif // TRIG_H
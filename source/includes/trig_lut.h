@@ -0,0 +1,17 @@
+// Generated by tools/gen_trig_lut.py, do not edit.
+
+#ifndef TRIG_LUT_H
+#define TRIG_LUT_H
+
+#include "types.h"
+#include "operamath.h"
+
+#define TRIG_LUT_BITS 10    // Sine entries per full turn, as a power of 2
+#define ATAN_LUT_BITS 8     // Arctangent entries per octant, as a power of 2
+#define SIN_LUT_SIZE 257    // Quarter wave plus the end point
+#define ATAN_LUT_SIZE 257
+
+extern const frac16 sin_lut[SIN_LUT_SIZE];
+extern const frac16 atan_lut[ATAN_LUT_SIZE];
+
+#endif // TRIG_LUT_H
@@ -2,6 +2,7 @@
 #include "gs_play.h"
 #include "audi.h"
 #include "levels.h"
+#include "folioref.h"
 
 // 3DO includes
 #include "graphics.h"
@@ -74,6 +75,10 @@ void init_core(void)
 	// Open folios
 	OpenGraphicsFolio();
 	OpenMathFolio();
+
+	#if DUMP_FOLIO_REFERENCE
+		folioref_dump();
+	#endif
 	
 	// Init audio
 	init_audio_core();
@@ -1,6 +1,7 @@
 // My includes.
 #include "app_globals.h"
 #include "maths.h"
+#include "fixmath.h"
 
 // 3DO includes.
 #include "string.h"
@@ -8,15 +9,15 @@
 
 void normalize_vector3(vec3f16 v)
 {
-    frac16 length = SqrtF16(SquareSF16(v[0]) + SquareSF16(v[1]) + SquareSF16(v[2]));
+    frac16 length = FIX_SQRT(FIX_SQUARE(v[0]) + FIX_SQUARE(v[1]) + FIX_SQUARE(v[2]));
 
     // This can happen with very small polygons due to 16.16 precision
     if (length == 0)
         length = ONE_F16;
 
-    v[0] = DivSF16(v[0], length); // x
-    v[1] = DivSF16(v[1], length); // y
-    v[2] = DivSF16(v[2], length); // z
+    v[0] = FIX_DIV(v[0], length); // x
+    v[1] = FIX_DIV(v[1], length); // y
+    v[2] = FIX_DIV(v[2], length); // z
 }
 
 void vector3_from_points(vec3f16 dest, vec3f16 a, vec3f16 b)
@@ -41,6 +42,6 @@ uint32 get_squared_dist(vec3f16 p1, vec3f16 p2)
     int32 a = p2[0] - p1[0];
     int32 b = p2[1] - p1[1];
     int32 c = p2[2] - p1[2];
-    int32 squared_dist = SquareSF16(a) + SquareSF16(b) + SquareSF16(c);
+    int32 squared_dist = FIX_SQUARE(a) + FIX_SQUARE(b) + FIX_SQUARE(c);
     return(squared_dist);
 }
@@ -0,0 +1,65 @@
+#include "pool.h"
+
+// 3DO includes
+#include "stdio.h"
+
+/* *************************************************************************************** */
+/* =========================== PUBLIC FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+void pool_reset(pool_typ_ptr pool)
+{
+    uint32 i;
+
+    #if DEBUG_MODE
+        if (pool->capacity > POOL_MAX_CAPACITY)
+            printf("Error - Pool capacity %d is too large.\n", pool->capacity);
+    #endif
+
+    // Highest slot at the bottom so slot 0 goes first
+    for (i = 0; i < pool->capacity; i++)
+    {
+        pool->free_slots[i] = (uint16) (pool->capacity - 1 - i);
+        pool->positions[i] = POOL_NONE;
+    }
+
+    pool->free_count = pool->capacity;
+    pool->active_count = 0;
+}
+
+uint32 pool_alloc(pool_typ_ptr pool)
+{
+    uint32 slot;
+
+    if (pool->free_count == 0)
+        return(POOL_NONE);
+
+    slot = pool->free_slots[--pool->free_count];
+
+    pool->positions[slot] = (uint16) pool->active_count;
+    pool->active[pool->active_count++] = (uint16) slot;
+
+    return(slot);
+}
+
+void pool_release(pool_typ_ptr pool, uint32 slot)
+{
+    uint32 position = pool->positions[slot];
+    uint32 last;
+
+    #if DEBUG_MODE
+        if (position == POOL_NONE)
+            printf("Error - Pool slot %d released twice.\n", slot);
+    #endif
+
+    if (position == POOL_NONE)
+        return;
+
+    // Fill the hole with the last active slot
+    last = pool->active[--pool->active_count];
+    pool->active[position] = (uint16) last;
+    pool->positions[last] = (uint16) position;
+
+    pool->positions[slot] = POOL_NONE;
+    pool->free_slots[pool->free_count++] = (uint16) slot;
+}
@@ -0,0 +1,205 @@
+#include "rqueue.h"
+
+// 3DO includes
+#include "stdio.h"
+#include "string.h"
+#include "mem.h"
+
+#define GROUP_NONE 0xFFFF
+
+// Bytes per entry of all the arrays grow_queue allocates
+#define RQUEUE_ENTRY_BYTES ((sizeof(polygon_typ_ptr) * 3) + (sizeof(uint16) * 2))
+
+/* *************************************************************************************** */
+/* ========================== PRIVATE FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+static Boolean grow_queue(rqueue_typ_ptr queue)
+{
+    uint32 capacity;
+    ubyte *block;
+
+    if (queue->capacity >= RQUEUE_BUDGET)
+        return(FALSE);
+
+    capacity = (queue->capacity) ? (queue->capacity << 1) : RQUEUE_INITIAL;
+
+    if (capacity > RQUEUE_BUDGET)
+        capacity = RQUEUE_BUDGET;
+
+    // One block, pointers first to keep them aligned
+    block = (ubyte*) AllocMem(RQUEUE_ENTRY_BYTES * capacity, MEMTYPE_DRAM);
+
+    if (!block)
+    {
+        #if DEBUG_MODE
+            printf("Error - render queue could not grow to %d.\n", capacity);
+        #endif
+
+        return(FALSE);
+    }
+
+    if (queue->capacity)
+    {
+        memcpy((void*)block, (void*)queue->items, sizeof(polygon_typ_ptr) * queue->size);
+        memcpy((void*)(block + sizeof(polygon_typ_ptr) * capacity * 2), (void*)queue->groups, sizeof(polygon_typ_ptr) * queue->group_count);
+        memcpy((void*)(block + sizeof(polygon_typ_ptr) * capacity * 3), (void*)queue->group_sizes, sizeof(uint16) * queue->group_count);
+        memcpy((void*)(block + sizeof(polygon_typ_ptr) * capacity * 3 + sizeof(uint16) * capacity), (void*)queue->group_links, sizeof(uint16) * queue->group_count);
+
+        FreeMem(queue->items, RQUEUE_ENTRY_BYTES * queue->capacity);
+    }
+
+    queue->items = (polygon_typ_ptr*) block;
+    queue->scratch = queue->items + capacity;
+    queue->groups = queue->scratch + capacity;
+    queue->group_sizes = (uint16*) (queue->groups + capacity);
+    queue->group_links = queue->group_sizes + capacity;
+    queue->capacity = capacity;
+
+    return(TRUE);
+}
+
+/*  Evict the newest groups of the lowest priorities below priority until count more 
+    entries fit. Nothing is evicted if they would not. */
+static Boolean make_room(rqueue_typ_ptr queue, uint32 count, uint32 priority)
+{
+    uint32 tier, spare;
+    uint16 group;
+
+    spare = queue->capacity - queue->size;
+
+    for (tier = 0; tier < priority && spare < count; tier++)
+        spare += queue->tier_sizes[tier];
+
+    if (spare < count)
+        return(FALSE);
+
+    tier = 0;
+
+    while (queue->size + count > queue->capacity)
+    {
+        group = queue->tier_tops[tier];
+
+        if (group == GROUP_NONE)
+        {
+            tier++;
+            continue;
+        }
+
+        queue->tier_tops[tier] = queue->group_links[group];
+        queue->tier_sizes[tier] -= queue->group_sizes[group];
+        queue->size -= queue->group_sizes[group];
+        queue->dropped += queue->group_sizes[group];
+
+        queue->groups[group] = NULL;
+        queue->group_links[group] = queue->free_groups;
+        queue->free_groups = group;
+        queue->packed = FALSE;
+    }
+
+    return(TRUE);
+}
+
+/* *************************************************************************************** */
+/* =========================== PUBLIC FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+void rqueue_reset(rqueue_typ_ptr queue)
+{
+    uint32 i;
+
+    for (i = 0; i < OBJ_PRIORITIES; i++)
+    {
+        queue->tier_tops[i] = GROUP_NONE;
+        queue->tier_sizes[i] = 0;
+    }
+
+    queue->group_count = 0;
+    queue->free_groups = GROUP_NONE;
+    queue->packed = TRUE;
+    queue->size = 0;
+    queue->dropped = 0;
+}
+
+Boolean rqueue_push(rqueue_typ_ptr queue, polygon_typ_ptr poly)
+{
+    uint32 count, priority;
+    uint16 group;
+    polygon_typ_ptr piece;
+
+    for (count = 1, piece = poly; piece->clip_split; piece = piece->clip_piece)
+        count++;
+
+    priority = poly->parent->priority;
+
+    #if DEBUG_MODE
+        if (priority >= OBJ_PRIORITIES)
+            printf("Error - object priority %d is out of range.\n", priority);
+    #endif
+
+    while (queue->size + count > queue->capacity && grow_queue(queue));
+
+    if (queue->size + count > queue->capacity && !make_room(queue, count, priority))
+    {
+        queue->dropped += count;
+        return(FALSE);
+    }
+
+    // Reuse an evicted record before taking a new one
+    if (queue->free_groups != GROUP_NONE)
+    {
+        group = queue->free_groups;
+        queue->free_groups = queue->group_links[group];
+    }
+    else 
+    {
+        group = (uint16) queue->group_count++;
+    }
+
+    queue->groups[group] = poly;
+    queue->group_sizes[group] = (uint16) count;
+    queue->group_links[group] = queue->tier_tops[priority];
+    queue->tier_tops[priority] = group;
+    queue->tier_sizes[priority] += count;
+
+    // Until something is evicted, items is filled as polygons arrive
+    if (queue->packed)
+    {
+        for (piece = poly; count--; piece = piece->clip_piece)
+            queue->items[queue->size++] = piece;
+    }
+    else 
+    {
+        queue->size += count;
+    }
+
+    if (queue->size > queue->high_water)
+        queue->high_water = queue->size;
+
+    return(TRUE);
+}
+
+void rqueue_pack(rqueue_typ_ptr queue)
+{
+    uint32 i, n, count;
+    polygon_typ_ptr piece;
+
+    if (queue->packed)
+        return;
+
+    for (i = 0, n = 0; i < queue->group_count; i++)
+    {
+        for (piece = queue->groups[i], count = (piece) ? queue->group_sizes[i] : 0; count--; piece = piece->clip_piece)
+            queue->items[n++] = piece;
+    }
+
+    queue->packed = TRUE;
+}
+
+void rqueue_free(rqueue_typ_ptr queue)
+{
+    if (queue->capacity)
+        FreeMem(queue->items, RQUEUE_ENTRY_BYTES * queue->capacity);
+
+    memset((void*)queue, 0, sizeof(rqueue_typ));
+}
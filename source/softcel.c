@@ -0,0 +1,382 @@
+#ifdef SOFTCEL
+
+#include "softcel.h"
+#include "cel_helper.h"
+
+// Host includes
+#include "stdio.h"
+#include "string.h"
+
+#define RGB555_R(c) (((c) >> 10) & 0x1F)
+#define RGB555_G(c) (((c) >> 5) & 0x1F)
+#define RGB555_B(c) ((c) & 0x1F)
+
+// PIXC half word fields
+#define PPMP_1S(p) (((p) >> 15) & 1)        // First source, 0 cel pixel, 1 frame buffer
+#define PPMP_MF(p) ((((p) >> 10) & 7) + 1)  // Multiply by 1 - 8
+#define PPMP_DF(p) (((p) >> 8) & 3)         // Divide by 16, 2, 4 or 8
+#define PPMP_2S(p) (((p) >> 6) & 3)         // Second source, 0, AV, frame buffer, cel pixel
+#define PPMP_AV(p) (((p) >> 1) & 0x1F)
+#define PPMP_2D(p) ((p) & 1)                // Halve the second source
+
+typedef struct softcel_source_typ
+{
+    ubyte *pixels;          // First row, SKIPX already applied
+    uint16 *plut;
+    int32 width;
+    int32 height;
+    int32 row_bytes;
+    uint32 ppmp;            // P-mode 0 half of PIXC
+    Boolean bgnd;           // 000 pixels are drawn instead of being transparent
+    uint32 facing;          // CCB_ACW and CCB_ACCW bits
+} softcel_source_typ, *softcel_source_typ_ptr;
+
+// One side of the cel outline while it is scan converted, all values 16.16
+typedef struct softcel_edge_typ
+{
+    int32 first_row;        // Pixel rows with a center on the edge
+    int32 end_row;
+    int64_t x;              // At the current row center
+    int64_t u;
+    int64_t v;
+    int64_t x_step;         // Per row
+    int64_t u_step;
+    int64_t v_step;
+} softcel_edge_typ, *softcel_edge_typ_ptr;
+
+static const int32 ppmp_div_shift[4] = {4, 1, 2, 3};
+
+/* *************************************************************************************** */
+/* ========================== PRIVATE FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+static int32 pixc_channel(uint32 ppmp, int32 cel, int32 dest)
+{
+    int32 first, second;
+
+    first = PPMP_1S(ppmp) ? dest : cel;
+    first = (first * PPMP_MF(ppmp)) >> ppmp_div_shift[ PPMP_DF(ppmp) ];
+
+    switch (PPMP_2S(ppmp))
+    {
+        case 1: second = PPMP_AV(ppmp); break;
+        case 2: second = dest; break;
+        case 3: second = cel; break;
+        default: second = 0; break;
+    }
+
+    if (PPMP_2D(ppmp))
+        second >>= 1;
+
+    first += second;
+
+    return((first > 31) ? 31 : first);
+}
+
+static uint16 pixc_blend(uint32 ppmp, uint16 cel, uint16 dest)
+{
+    // Multiply by 8, divide by 8, add 0 is a straight copy
+    if ((ppmp & 0x7FFF) == 0x1F00)
+        return(cel);
+
+    return((uint16) ((pixc_channel(ppmp, RGB555_R(cel), RGB555_R(dest)) << 10) | 
+        (pixc_channel(ppmp, RGB555_G(cel), RGB555_G(dest)) << 5) | 
+        pixc_channel(ppmp, RGB555_B(cel), RGB555_B(dest))));
+}
+
+static Boolean load_source(softcel_source_typ_ptr src, CCB *ccb, uint16 *plut)
+{
+    int32 skipx;
+
+    if (GET_CEL_UNCODED(ccb) || GET_CEL_BPP_VALUE(ccb) != PRE0_BPP_8 || (ccb->ccb_Flags & CCB_PACKED) || !plut)
+        return(FALSE);
+
+    skipx = GET_CEL_SKIPX(ccb);
+
+    src->plut = plut;
+    src->width = GET_CEL_TLHPCNT(ccb) + PRE1_TLHPCNT_PREFETCH - skipx;
+    src->height = GET_CEL_VCNT(ccb) + PRE0_VCNT_PREFETCH;
+    src->row_bytes = (GET_CEL_WOFFSET10(ccb) + PRE1_WOFFSET_PREFETCH) << 2;
+    src->pixels = ((ubyte*) ccb->ccb_SourcePtr) + skipx;
+    src->ppmp = ccb->ccb_PIXC & 0xFFFF;
+    src->bgnd = (ccb->ccb_Flags & CCB_BGND) ? TRUE : FALSE;
+    src->facing = ccb->ccb_Flags & (CCB_ACW | CCB_ACCW);
+
+    return(src->width > 0 && src->height > 0);
+}
+
+/*  Step an edge to the first pixel center row at or below its top corner. Values are 16.16,
+    u and v in source pixels. Returns FALSE if no row center of the target falls on the edge. */
+static Boolean setup_edge(softcel_edge_typ_ptr edge, int32 *x, int32 *y, int32 *u, int32 *v, int32 a, int32 b)
+{
+    int32 temp;
+    int64_t dy, offset;
+
+    if (y[a] == y[b])
+        return(FALSE);
+
+    if (y[a] > y[b])
+    {
+        temp = a;
+        a = b;
+        b = temp;
+    }
+
+    // Rows whose center is in [top, bottom), pixel centers are at n + 0.5. Rows above the target are skipped.
+    edge->first_row = (y[a] - 0x8000 + 0xFFFF) >> 16;
+    edge->end_row = (y[b] - 0x8000 + 0xFFFF) >> 16;
+
+    if (edge->first_row < 0)
+        edge->first_row = 0;
+
+    if (edge->first_row >= edge->end_row)
+        return(FALSE);
+
+    dy = y[b] - y[a];
+    offset = ((int64_t) edge->first_row << 16) + 0x8000 - y[a];
+
+    edge->x_step = ((int64_t) (x[b] - x[a]) << 16) / dy;
+    edge->u_step = ((int64_t) (u[b] - u[a]) << 16) / dy;
+    edge->v_step = ((int64_t) (v[b] - v[a]) << 16) / dy;
+    edge->x = x[a] + ((edge->x_step * offset) >> 16);
+    edge->u = u[a] + ((edge->u_step * offset) >> 16);
+    edge->v = v[a] + ((edge->v_step * offset) >> 16);
+
+    return(TRUE);
+}
+
+// Draw pixel centers in [left->x, right->x) of one row, stepping u and v across the span
+static void draw_span(softcel_target_typ_ptr target, softcel_source_typ_ptr src, int32 py, 
+    softcel_edge_typ_ptr left, softcel_edge_typ_ptr right)
+{
+    int32 px, end_x, tu, tv;
+    int64_t u, v, u_step, v_step, width, offset;
+    uint16 *dest;
+    uint16 color;
+
+    px = (int32) ((left->x - 0x8000 + 0xFFFF) >> 16);
+    end_x = (int32) ((right->x - 0x8000 + 0xFFFF) >> 16);
+    width = right->x - left->x;
+
+    if (px >= end_x || width <= 0)
+        return;
+
+    u_step = ((right->u - left->u) << 16) / width;
+    v_step = ((right->v - left->v) << 16) / width;
+    offset = ((int64_t) px << 16) + 0x8000 - left->x;
+    u = left->u + ((u_step * offset) >> 16);
+    v = left->v + ((v_step * offset) >> 16);
+
+    if (px < 0)
+    {
+        u -= u_step * px;
+        v -= v_step * px;
+        px = 0;
+    }
+
+    if (end_x > target->width)
+        end_x = target->width;
+
+    dest = target->pixels + py * target->width + px;
+
+    for (; px < end_x; px++, dest++, u += u_step, v += v_step)
+    {
+        tu = (int32) (u >> 16);
+        tv = (int32) (v >> 16);
+
+        // Steps round, keep the edge pixels on the source
+        if (tu < 0) tu = 0;
+        if (tu >= src->width) tu = src->width - 1;
+        if (tv < 0) tv = 0;
+        if (tv >= src->height) tv = src->height - 1;
+
+        color = src->plut[ src->pixels[tv * src->row_bytes + tu] & 0x1F ];
+
+        if (color == 0 && !src->bgnd)
+            continue;
+
+        *dest = pixc_blend(src->ppmp, color, *dest);
+        target->pixels_written++;
+    }
+}
+
+/*  The CEL engine steps VDX / VDY per row and HDX / HDY per pixel, so the cel covers the
+    quad between its four corners. HDX, HDY and their per row deltas are 12.20, positions
+    16.16. The quad is scan converted once, with u and v exact along its sides and stepped
+    linearly across each span. Outlines are treated as convex, which every mapping the
+    game makes is. */
+static void draw_cel(softcel_target_typ_ptr target, softcel_source_typ_ptr src, CCB *ccb)
+{
+    int32 i, py, last_row;
+    int32 x[4], y[4], u[4], v[4];
+    int32 hdx_end, hdy_end;
+    int64_t area;
+    softcel_edge_typ edges[4];
+    softcel_edge_typ_ptr active[4];
+    softcel_edge_typ_ptr left, right;
+    uint32 active_count, edge_count;
+
+    hdx_end = ccb->ccb_HDX + src->height * ccb->ccb_HDDX;
+    hdy_end = ccb->ccb_HDY + src->height * ccb->ccb_HDDY;
+
+    x[0] = ccb->ccb_XPos;
+    y[0] = ccb->ccb_YPos;
+    x[1] = x[0] + src->width * (ccb->ccb_HDX >> 4);
+    y[1] = y[0] + src->width * (ccb->ccb_HDY >> 4);
+    x[3] = x[0] + src->height * ccb->ccb_VDX;
+    y[3] = y[0] + src->height * ccb->ccb_VDY;
+    x[2] = x[3] + src->width * (hdx_end >> 4);
+    y[2] = y[3] + src->width * (hdy_end >> 4);
+
+    u[0] = u[3] = 0;
+    u[1] = u[2] = src->width << 16;
+    v[0] = v[1] = 0;
+    v[2] = v[3] = src->height << 16;
+
+    area = 0;
+
+    for (i = 0; i < 4; i++)
+        area += (int64_t) x[i] * y[(i + 1) & 3] - (int64_t) x[(i + 1) & 3] * y[i];
+
+    // Positive area is clockwise on screen since y grows downward
+    if (area == 0 || !(src->facing & ((area > 0) ? CCB_ACW : CCB_ACCW)))
+        return;
+
+    edge_count = 0;
+    py = 0x7FFFFFFF;
+    last_row = -0x7FFFFFFF;
+
+    for (i = 0; i < 4; i++)
+    {
+        if (!setup_edge(&edges[edge_count], x, y, u, v, i, (i + 1) & 3))
+            continue;
+
+        if (edges[edge_count].first_row < py)
+            py = edges[edge_count].first_row;
+
+        if (edges[edge_count].end_row > last_row)
+            last_row = edges[edge_count].end_row;
+
+        edge_count++;
+    }
+
+    if (last_row > target->height)
+        last_row = target->height;
+
+    for (; py < last_row; py++)
+    {
+        active_count = 0;
+
+        for (i = 0; i < (int32) edge_count; i++)
+        {
+            if (py >= edges[i].first_row && py < edges[i].end_row)
+                active[active_count++] = &edges[i];
+        }
+
+        if (active_count >= 2)
+        {
+            left = right = active[0];
+
+            for (i = 1; i < (int32) active_count; i++)
+            {
+                if (active[i]->x < left->x)
+                    left = active[i];
+
+                if (active[i]->x > right->x)
+                    right = active[i];
+            }
+
+            draw_span(target, src, py, left, right);
+        }
+
+        for (i = 0; i < (int32) active_count; i++)
+        {
+            active[i]->x += active[i]->x_step;
+            active[i]->u += active[i]->u_step;
+            active[i]->v += active[i]->v_step;
+        }
+    }
+}
+
+/* *************************************************************************************** */
+/* =========================== PUBLIC FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+void softcel_clear(softcel_target_typ_ptr target, uint16 color)
+{
+    int32 i = target->width * target->height;
+    uint16 *dest = target->pixels;
+
+    while (i-- > 0)
+        *dest++ = color;
+
+    target->cels_drawn = 0;
+    target->cels_skipped = 0;
+    target->cels_unsupported = 0;
+    target->pixels_written = 0;
+}
+
+void softcel_draw(softcel_target_typ_ptr target, CCB *ccb)
+{
+    softcel_source_typ src;
+    uint16 *plut = NULL;
+
+    while (ccb)
+    {
+        // A PLUT stays loaded for following cels that do not bring their own
+        if (ccb->ccb_Flags & CCB_LDPLUT)
+            plut = (uint16*) ccb->ccb_PLUTPtr;
+
+        if (ccb->ccb_Flags & CCB_SKIP)
+        {
+            target->cels_skipped++;
+        }
+        else if (load_source(&src, ccb, plut))
+        {
+            draw_cel(target, &src, ccb);
+            target->cels_drawn++;
+        }
+        else 
+        {
+            target->cels_unsupported++;
+        }
+
+        if (ccb->ccb_Flags & CCB_LAST)
+            break;
+
+        ccb = ccb->ccb_NextPtr;
+    }
+}
+
+int32 softcel_write_ppm(softcel_target_typ_ptr target, char *file_path)
+{
+    FILE *fout;
+    int32 i;
+    uint16 c;
+    ubyte rgb[3];
+
+    fout = fopen(file_path, "wb");
+
+    if (!fout)
+        return(-1);
+
+    fprintf(fout, "P6\n%d %d\n255\n", (int) target->width, (int) target->height);
+
+    for (i = 0; i < target->width * target->height; i++)
+    {
+        c = target->pixels[i];
+
+        // Expand 5 bit channels to 8 bits
+        rgb[0] = (ubyte) ((RGB555_R(c) << 3) | (RGB555_R(c) >> 2));
+        rgb[1] = (ubyte) ((RGB555_G(c) << 3) | (RGB555_G(c) >> 2));
+        rgb[2] = (ubyte) ((RGB555_B(c) << 3) | (RGB555_B(c) >> 2));
+
+        fwrite(rgb, 1, 3, fout);
+    }
+
+    fclose(fout);
+
+    return(0);
+}
+
+#endif // SOFTCEL
@@ -2,6 +2,10 @@
 #include "maths.h"
 #include "resources.h"
 #include "cel_helper.h"
+#include "rqueue.h"
+#include "trig.h"
+#include "fixmath.h"
+#include "dlist.h"
 
 // 3DO includes
 #include "stdio.h"
@@ -15,26 +19,828 @@
 
 #define VIEW_DIST_SHIFT 8       // 2 ^ 8, or 256 view distance
 #define VIEW_DIST_F16 16777216
-#define MAX_POLY_RASTER 120
 // #define CAM_Z_TO_LUT(z) (((z >> 4) << 11) >> FRACBITS_16) // z / 16 * 2048
 #define CAM_Z_TO_LUT(z) ((z << 7) >> FRACBITS_16) // z / 16 * 2048
 #define Z_LUT_SIZE 2048
+#define SORT_BUCKETS 64
+#define SORT_BUCKET_SHIFT 14    // Quarter unit per bucket, covers camera z 0 - 16
+#define CACHE_MODE_NONE 0       // Object screen vertices have not been built
+#define CACHE_MODE_LUT 1
+#define CACHE_MODE_DIV 2
+#define CACHE_MODE_ZCLIP 3
+
+#define ORTHONORMAL_STEPS 16 // Compositions between clean ups of an object's rotation
+#define CLIP_MAX_VERTS 9 // A quad gains at most one corner from the near plane and four from the guard band
 
 /* *************************************************************************************** */
 /* ===================================== GLOBALS ========================================= */
 /* *************************************************************************************** */
 
-camera_typ camera;
+camera_typ camera;
+render_stats_typ render_stats;
+
+/* *************************************************************************************** */
+/* ================================== PRIVATE VARS ======================================= */
+/* *************************************************************************************** */
+
+static rqueue_typ poly_queue;
+
+// This is very specific to level logic
+static int32 inv_depth_table[Z_LUT_SIZE];
+
+// Depth sorting
+static uint32 sort_counts[SORT_BUCKETS];
+static uint32 sort_frame = 0;
+static uint32 sort_prev_size = 0;
+
+// Normalized side plane coefficients, set by init_3d
+static frac16 frustum_x_nx = 0;
+static frac16 frustum_x_nz = 0;
+static frac16 frustum_y_ny = 0;
+static frac16 frustum_y_nz = 0;
+
+// Camera position the current camera version was issued for
+static int32 version_cam_x = 0;
+static int32 version_cam_y = 0;
+static int32 version_cam_z = 0;
+
+// CCB order the 3D layer was linked in last frame, see end_3d
+static CCB *linked_ccbs[RQUEUE_BUDGET];
+static uint32 linked_size = 0;
+static Boolean links_valid = FALSE;
+
+// Bumped by every raster_scene_wireframe call, see edge_typ
+static uint32 wire_frame = 0;
+
+// Guard band rectangle in 16.16 screen space, see set_guard_band
+static uint32 guard_mode = GUARD_BAND_CLIP;
+static frac16 guard_left = 0;
+static frac16 guard_top = 0;
+static frac16 guard_right = 0;
+static frac16 guard_bottom = 0;
+
+/* *************************************************************************************** */
+/* ========================== PRIVATE FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+// Far polygons land in low buckets so the list comes out back to front
+static uint32 avgz_to_bucket(int32 avgz)
+{
+    avgz >>= SORT_BUCKET_SHIFT;
+
+    if (avgz < 0) 
+        avgz = 0;
+    else if (avgz >= SORT_BUCKETS) 
+        avgz = SORT_BUCKETS - 1;
+
+    return(SORT_BUCKETS - 1 - avgz);
+}
+
+// Stable counting pass over the buckets
+static void bucket_sort_polys(void)
+{
+    uint32 i;
+    uint32 sum, count;
+
+    memset((void*)sort_counts, 0, sizeof(uint32) * SORT_BUCKETS);
+
+    for (i = 0; i < poly_queue.size; i++)
+        ++sort_counts[ avgz_to_bucket(poly_queue.items[i]->avgz) ];
+
+    for (i = 0, sum = 0; i < SORT_BUCKETS; i++)
+    {
+        count = sort_counts[i];
+        sort_counts[i] = sum;
+        sum += count;
+    }
+
+    for (i = 0; i < poly_queue.size; i++)
+        poly_queue.scratch[ sort_counts[ avgz_to_bucket(poly_queue.items[i]->avgz) ]++ ] = poly_queue.items[i];
+
+    memcpy((void*)poly_queue.items, (void*)poly_queue.scratch, sizeof(polygon_typ_ptr) * poly_queue.size);
+}
+
+/*  If the exact same polygons were sorted last frame, start from last frame's order.
+    Objects rarely move far in one frame, so the insertion pass after this is close to linear. */
+static Boolean reuse_sort_order(void)
+{
+    uint32 i;
+
+    if (poly_queue.size != sort_prev_size)
+        return(FALSE);
+
+    for (i = 0; i < poly_queue.size; i++)
+    {
+        if (poly_queue.items[i]->sort_stamp != sort_frame)
+            return(FALSE);
+    }
+
+    for (i = 0; i < poly_queue.size; i++)
+        poly_queue.scratch[ poly_queue.items[i]->sort_rank ] = poly_queue.items[i];
+
+    memcpy((void*)poly_queue.items, (void*)poly_queue.scratch, sizeof(polygon_typ_ptr) * poly_queue.size);
+
+    return(TRUE);
+}
+
+// Settles order within buckets. Strict compare keeps equal depths in their current order.
+static void insertion_sort_polys(void)
+{
+    uint32 i, j;
+    polygon_typ_ptr temp;
+
+    for (i = 1; i < poly_queue.size; i++)
+    {
+        temp = poly_queue.items[i];
+        j = i;
+
+        while (j > 0 && poly_queue.items[j-1]->avgz < temp->avgz)
+        {
+            poly_queue.items[j] = poly_queue.items[j-1];
+            --j;
+        }
+
+        poly_queue.items[j] = temp;
+    }
+}
+
+static void alloc_obj_vertex_cache(object_typ_ptr obj)
+{
+    obj->camera_verts = (vec3f16*) AllocMem(sizeof(vec3f16) * obj->vertex_def.vertex_count, MEMTYPE_DRAM);
+    obj->screen_verts = (Point*) AllocMem(sizeof(Point) * obj->vertex_def.vertex_count, MEMTYPE_DRAM);
+}
+
+static void build_z_matrix(mat33f16 m, frac16 sn, frac16 cs)
+{
+    m[0][0] = cs;  m[0][1] = -sn;     m[0][2] = 0;
+    m[1][0] = sn;  m[1][1] = cs;      m[1][2] = 0;
+    m[2][0] = 0;   m[2][1] = 0;       m[2][2] = ONE_F16;
+}
+
+/*  Writes rotx * roty * rotz directly, the same x then y then z order as chaining 
+    the single axis matrices. Axes with a zero angle cost nothing to look up. */
+static void build_euler_matrix(mat33f16 m, vec3f16 angles)
+{
+    frac16 sx, cx, sy, cy, sz, cz;
+    frac16 sxsy, cxsy;
+
+    sx = sy = sz = 0;
+    cx = cy = cz = ONE_F16;
+
+    if (angles[0]) sincos_f16(angles[0], &sx, &cx);
+    if (angles[1]) sincos_f16(angles[1], &sy, &cy);
+    if (angles[2]) sincos_f16(angles[2], &sz, &cz);
+
+    sxsy = FIX_MUL(sx, sy);
+    cxsy = FIX_MUL(cx, sy);
+
+    m[0][0] = FIX_MUL(cy, cz);
+    m[0][1] = -FIX_MUL(cy, sz);
+    m[0][2] = sy;
+
+    m[1][0] = FIX_MUL(sxsy, cz) + FIX_MUL(cx, sz);
+    m[1][1] = FIX_MUL(cx, cz) - FIX_MUL(sxsy, sz);
+    m[1][2] = -FIX_MUL(sx, cy);
+
+    m[2][0] = FIX_MUL(sx, sz) - FIX_MUL(cxsy, cz);
+    m[2][1] = FIX_MUL(cxsy, sz) + FIX_MUL(sx, cz);
+    m[2][2] = FIX_MUL(cx, cy);
+}
+
+/*  Rounding in each composition leaves rows slightly off unit length and off square, 
+    which would slowly skew and scale the model. Rebuild them as an orthonormal set. */
+static void orthonormalize_matrix(mat33f16 m)
+{
+    frac16 d;
+
+    normalize_vector3(m[0]);
+
+    d = FIX_DOT3(m[0], m[1]);
+    m[1][0] -= FIX_MUL(d, m[0][0]);
+    m[1][1] -= FIX_MUL(d, m[0][1]);
+    m[1][2] -= FIX_MUL(d, m[0][2]);
+    normalize_vector3(m[1]);
+
+    FIX_CROSS3(m[2], m[0], m[1]);
+}
+
+// Apply rotation after the object's current rotation
+static void compose_obj_rotation(object_typ_ptr obj, mat33f16 rotation)
+{
+    mat33f16 temp;
+
+    if (obj->rotated)
+    {
+        FIX_MUL_MAT33_MAT33(temp, obj->rotation, rotation);
+        COPY_MAT33F16(obj->rotation, temp);
+
+        if (++obj->rotation_steps >= ORTHONORMAL_STEPS)
+        {
+            orthonormalize_matrix(obj->rotation);
+            obj->rotation_steps = 0;
+        }
+    }
+    else 
+    {
+        COPY_MAT33F16(obj->rotation, rotation);
+        obj->rotated = TRUE;
+        obj->rotation_steps = 0;
+    }
+
+    MARK_OBJ_DIRTY(obj);
+}
+
+// World and camera translation folded into one offset, applied once per shared vertex
+static void obj_to_camera(object_typ_ptr obj)
+{
+    int32 i;
+    int32 offset_x, offset_y, offset_z;
+    vertex_typ_ptr vtyp;
+    vec3f16 *cam;
+
+    offset_x = obj->world_x - camera.world_x;
+    offset_y = obj->world_y - camera.world_y;
+    offset_z = obj->world_z - camera.world_z;
+
+    cam = obj->camera_verts;
+
+    i = obj->vertex_def.vertex_count;
+
+    if (obj->rotated)
+    {
+        // Rotate all vertices in one call, then translate in place
+        FIX_MUL_MANY_VEC3_MAT33(cam, (vec3f16*) obj->vertex_def.vertices, obj->rotation, i);
+
+        while (i--)
+        {
+            (*cam)[VERTEX_X] += offset_x;
+            (*cam)[VERTEX_Y] += offset_y;
+            (*cam)[VERTEX_Z] += offset_z;
+
+            cam++;
+        }
+
+        return;
+    }
+
+    vtyp = obj->vertex_def.vertices;
+
+    while (i--)
+    {
+        (*cam)[VERTEX_X] = vtyp->vertex[VERTEX_X] + offset_x;
+        (*cam)[VERTEX_Y] = vtyp->vertex[VERTEX_Y] + offset_y;
+        (*cam)[VERTEX_Z] = vtyp->vertex[VERTEX_Z] + offset_z;
+
+        vtyp++;
+        cam++;
+    }
+}
+
+static void obj_to_screen(object_typ_ptr obj, Boolean use_inv_lut)
+{
+    int32 i;
+    int32 z;
+    int32 lut_index;
+    int32 lut_value;
+    vec3f16 *cam;
+    Point *screen;
+
+    cam = obj->camera_verts;
+    screen = obj->screen_verts;
+
+    i = obj->vertex_def.vertex_count;
+
+    if (use_inv_lut)
+    {
+        while (i--)
+        {
+            z = (*cam)[VERTEX_Z];
+
+            if (z < 0) 
+                z = -z; // Positive only during calc
+
+            // Z should be within the range 0 - 16
+            lut_index = CAM_Z_TO_LUT(z);
+
+            if (lut_index < 0) lut_index = 0;
+            else if (lut_index >= 2048) lut_index = 2047;
+
+            lut_value = inv_depth_table[lut_index];
+
+            if ((*cam)[VERTEX_Z] < 0)
+                lut_value = -lut_value; // Go back to negative if needed
+
+            screen->pt_X = FIX_MUL((*cam)[VERTEX_X] << VIEW_DIST_SHIFT, lut_value) + display_width2_f16;
+            screen->pt_Y = FIX_MUL(-(*cam)[VERTEX_Y] << VIEW_DIST_SHIFT, lut_value) + display_height2_f16;
+
+            cam++;
+            screen++;
+        }
+    }
+    else 
+    {
+        while (i--)
+        {
+            z = (*cam)[VERTEX_Z];
+
+            if (z == 0) 
+                z = 1;
+
+            screen->pt_X = FIX_DIV((*cam)[VERTEX_X] << VIEW_DIST_SHIFT, z) + display_width2_f16;
+            screen->pt_Y = FIX_DIV(-(*cam)[VERTEX_Y] << VIEW_DIST_SHIFT, z) + display_height2_f16;
+
+            cam++;
+            screen++;
+        }
+    }
+}
+
+// Vertices behind the near plane are projected as if they were sitting on it
+static void obj_to_screen_clip(object_typ_ptr obj, int32 near)
+{
+    fix_project_points_f16(obj->screen_verts, obj->camera_verts, obj->vertex_def.vertex_count, VIEW_DIST_SHIFT, near, 
+        display_width2_f16, display_height2_f16);
+}
+
+static void sync_camera_version(void)
+{
+    if (camera.world_x != version_cam_x || camera.world_y != version_cam_y || camera.world_z != version_cam_z)
+    {
+        version_cam_x = camera.world_x;
+        version_cam_y = camera.world_y;
+        version_cam_z = camera.world_z;
+        camera.version++;
+    }
+}
+
+/*  Test the object's bounding sphere against the near plane and the four side planes.
+    Objects without a collision radius are always drawn. */
+static Boolean obj_in_frustum(object_typ_ptr obj, int32 near)
+{
+    int32 r;
+    int32 cx, cy, cz;
+
+    if (obj->bsphere_radius == 0)
+        return(TRUE);
+
+    // Resized since the radius was measured, such as by scale_obj
+    if (obj->cull_version != obj->shape_version)
+    {
+        obj->cull_radius = calc_bsphere_radius(obj);
+        obj->cull_version = obj->shape_version;
+    }
+
+    r = (int32) obj->cull_radius;
+
+    cx = obj->world_x - camera.world_x;
+    cy = obj->world_y - camera.world_y;
+    cz = obj->world_z - camera.world_z;
+
+    if (cz + r <= near)
+        return(FALSE);
+
+    // Planes are symmetric so left / right and top / bottom share one test
+    
+    if (cx < 0) cx = -cx;
+    if (cy < 0) cy = -cy;
+
+    if (FIX_MUL(frustum_x_nx, cx) - FIX_MUL(frustum_x_nz, cz) > r)
+        return(FALSE);
+
+    if (FIX_MUL(frustum_y_ny, cy) - FIX_MUL(frustum_y_nz, cz) > r)
+        return(FALSE);
+
+    return(TRUE);
+}
+
+// Normals point toward the viewer, so a face pointing the same way as the view ray is culled
+static Boolean is_backface(polygon_typ_ptr poly, vec3f16 *cam)
+{
+    vec3f16 normal;
+
+    if (!poly->parent->rotated)
+        return(FIX_DOT3(poly->normal, cam[ poly->vertex_lut[0] ]) >= 0);
+
+    // Normals are in object space
+    FIX_MUL_VEC3_MAT33(normal, poly->normal, poly->parent->rotation);
+
+    return(FIX_DOT3(normal, cam[ poly->vertex_lut[0] ]) >= 0);
+}
+
+static void sync_obj_normals(object_typ_ptr obj)
+{
+    if (obj->normals_version != obj->version)
+        calc_obj_normals(obj);
+}
+
+// TRUE if the object's screen vertices were built from the same inputs
+static Boolean obj_cache_valid(object_typ_ptr obj, int32 mode, int32 near)
+{
+    return(obj->cache_mode == mode &&
+        obj->cache_near == near &&
+        obj->cache_flags == obj->flags &&
+        obj->cache_version == obj->version &&
+        obj->cache_cam_version == camera.version &&
+        obj->cache_world_x == obj->world_x &&
+        obj->cache_world_y == obj->world_y &&
+        obj->cache_world_z == obj->world_z);
+}
+
+static void save_obj_cache(object_typ_ptr obj, int32 mode, int32 near)
+{
+    obj->cache_mode = mode;
+    obj->cache_near = near;
+    obj->cache_flags = obj->flags;
+    obj->cache_version = obj->version;
+    obj->cache_cam_version = camera.version;
+    obj->cache_world_x = obj->world_x;
+    obj->cache_world_y = obj->world_y;
+    obj->cache_world_z = obj->world_z;
+}
+
+/*  Sutherland-Hodgman against the plane z = near. Corners keep the polygon's winding.
+    Returns the number of corners written to out, 0 - 5. */
+static uint32 clip_poly_near(polygon_typ_ptr poly, vec3f16 *cam, int32 near, vec3f16 *out)
+{
+    uint32 i, n;
+    frac16 t;
+    vec3f16 *a, *b;
+
+    for (i = 0, n = 0; i < 4; i++)
+    {
+        a = &cam[ poly->vertex_lut[i] ];
+        b = &cam[ poly->vertex_lut[(i + 1) & 3] ];
+
+        if ((*a)[VERTEX_Z] >= near)
+        {
+            memcpy((void*)out[n], (void*)*a, sizeof(vec3f16));
+            n++;
+        }
+
+        if (((*a)[VERTEX_Z] >= near) != ((*b)[VERTEX_Z] >= near))
+        {
+            // Edge crosses the plane, t is 0 - 1 along a to b
+            t = FIX_DIV(near - (*a)[VERTEX_Z], (*b)[VERTEX_Z] - (*a)[VERTEX_Z]);
+
+            out[n][VERTEX_X] = (*a)[VERTEX_X] + FIX_MUL((*b)[VERTEX_X] - (*a)[VERTEX_X], t);
+            out[n][VERTEX_Y] = (*a)[VERTEX_Y] + FIX_MUL((*b)[VERTEX_Y] - (*a)[VERTEX_Y], t);
+            out[n][VERTEX_Z] = near;
+            n++;
+        }
+    }
+
+    return(n);
+}
+
+// Next piece in the polygon's chain, allocated on first use
+static polygon_typ_ptr get_clip_piece(polygon_typ_ptr poly, polygon_typ_ptr prev)
+{
+    polygon_typ_ptr piece = prev->clip_piece;
+    CCB *next;
+    uint32 last;
+
+    if (!piece)
+    {
+        piece = (polygon_typ_ptr) AllocMem(sizeof(polygon_typ), MEMTYPE_DRAM);
+
+        if (!piece)
+            return(NULL);
+
+        memset((void*)piece, 0, sizeof(polygon_typ));
+        piece->parent = poly->parent;
+        piece->screen_clipped = TRUE; // Always a part of an outline
+        piece->ccb = (CCB*) AllocMem(sizeof(CCB), MEMTYPE_CEL);
+
+        if (!piece->ccb)
+        {
+            FreeMem(piece, sizeof(polygon_typ));
+
+            #if DEBUG_MODE
+                printf("Error - could not allocate clip piece.\n");
+            #endif
+
+            return(NULL);
+        }
+
+        prev->clip_piece = piece;
+    }
+
+    // Same source, palette and flags as the polygon, only the corners and display list link differ
+    next = piece->ccb->ccb_NextPtr;
+    last = piece->ccb->ccb_Flags & CCB_LAST;
+
+    memcpy((void*)piece->ccb, (void*)poly->ccb, sizeof(CCB));
+
+    piece->ccb->ccb_NextPtr = next;
+    piece->ccb->ccb_Flags = (piece->ccb->ccb_Flags & ~CCB_LAST) | last;
+
+    return(piece);
+}
+
+static void free_clip_piece(polygon_typ_ptr poly)
+{
+    polygon_typ_ptr piece = poly->clip_piece;
+    polygon_typ_ptr next;
+
+    while (piece)
+    {
+        next = piece->clip_piece;
+        FreeMem(piece->ccb, sizeof(CCB));
+        FreeMem(piece, sizeof(polygon_typ));
+        piece = next;
+    }
+
+    poly->clip_piece = NULL;
+}
+
+/*  Fan a convex outline of 3 - CLIP_MAX_VERTS corners into quads. The first quad goes
+    on the polygon's CCB, the rest on its clip pieces. A lone triangle doubles its last corner. */
+static void map_outline(polygon_typ_ptr poly, Point *screen, uint32 n)
+{
+    uint32 i = 1;
+    polygon_typ_ptr piece = poly;
+    polygon_typ_ptr next;
+
+    for (;;)
+    {
+        piece->clip_split = FALSE;
+        piece->avgz = poly->avgz;
+        piece->screen[0] = screen[0];
+        piece->screen[1] = screen[i];
+        piece->screen[2] = screen[i + 1];
+        piece->screen[3] = (i + 2 < n) ? screen[i + 2] : screen[i + 1];
+
+        FastMapCelf16(piece->ccb, piece->screen);
+
+        i += 2;
+
+        if (i + 1 >= n)
+            break;
+
+        next = get_clip_piece(poly, piece);
+
+        if (!next)
+            break;
+
+        piece->clip_split = TRUE;
+        piece = next;
+    }
+}
+
+static Boolean outline_in_guard(Point *screen, uint32 n)
+{
+    while (n--)
+    {
+        if (screen->pt_X < guard_left || screen->pt_X > guard_right || 
+            screen->pt_Y < guard_top || screen->pt_Y > guard_bottom)
+            return(FALSE);
+
+        screen++;
+    }
+
+    return(TRUE);
+}
+
+// Bounding box test, the outline may still miss the band when this passes
+static Boolean outline_overlaps_guard(Point *screen, uint32 n)
+{
+    frac16 left = screen->pt_X;
+    frac16 right = screen->pt_X;
+    frac16 top = screen->pt_Y;
+    frac16 bottom = screen->pt_Y;
+
+    while (--n)
+    {
+        screen++;
+
+        if (screen->pt_X < left)
+            left = screen->pt_X;
+        else if (screen->pt_X > right)
+            right = screen->pt_X;
+
+        if (screen->pt_Y < top)
+            top = screen->pt_Y;
+        else if (screen->pt_Y > bottom)
+            bottom = screen->pt_Y;
+    }
+
+    return(right >= guard_left && left <= guard_right && bottom >= guard_top && top <= guard_bottom);
+}
+
+static frac16 outline_coord(Point *pt, Boolean use_y)
+{
+    return(use_y ? pt->pt_Y : pt->pt_X);
+}
+
+/*  One Sutherland-Hodgman pass in screen space. Keeps the side of the line coord = limit
+    where coord <= limit, or coord >= limit when keep_greater is set. */
+static uint32 clip_outline_edge(Point *in, uint32 n, Point *out, Boolean use_y, Boolean keep_greater, frac16 limit)
+{
+    uint32 i, count;
+    frac16 ca, cb, t;
+    Boolean a_in, b_in;
+    Point *a, *b;
+
+    for (i = 0, count = 0; i < n; i++)
+    {
+        a = &in[i];
+        b = &in[(i + 1 == n) ? 0 : i + 1];
+        ca = outline_coord(a, use_y);
+        cb = outline_coord(b, use_y);
+        a_in = keep_greater ? (ca >= limit) : (ca <= limit);
+        b_in = keep_greater ? (cb >= limit) : (cb <= limit);
+
+        if (a_in)
+            out[count++] = *a;
+
+        if (a_in != b_in)
+        {
+            t = FIX_DIV(limit - ca, cb - ca);
+
+            if (use_y)
+            {
+                out[count].pt_X = a->pt_X + FIX_MUL(b->pt_X - a->pt_X, t);
+                out[count].pt_Y = limit;
+            }
+            else 
+            {
+                out[count].pt_X = limit;
+                out[count].pt_Y = a->pt_Y + FIX_MUL(b->pt_Y - a->pt_Y, t);
+            }
+
+            count++;
+        }
+    }
+
+    return(count);
+}
+
+// Cut the outline in place to the guard rectangle, screen must hold CLIP_MAX_VERTS corners
+static uint32 clip_outline_to_guard(Point *screen, uint32 n)
+{
+    Point temp[CLIP_MAX_VERTS];
+
+    n = clip_outline_edge(screen, n, temp, FALSE, TRUE, guard_left);
+    n = clip_outline_edge(temp, n, screen, FALSE, FALSE, guard_right);
+    n = clip_outline_edge(screen, n, temp, TRUE, TRUE, guard_top);
+    n = clip_outline_edge(temp, n, screen, TRUE, FALSE, guard_bottom);
+
+    return(n);
+}
+
+/*  Guard band stage between projection and the CEL engine. Oversized corners stall the CEL
+    engine, so outlines reaching past the guard rectangle are cut to it or rejected.
+    The whole cel is squeezed into a cut outline, so only single color cels are cut.
+    Textured outlines that still overlap the band go through whole.
+    Returns FALSE if nothing is left to draw. */
+static Boolean map_poly_screen(polygon_typ_ptr poly, Point *screen, uint32 n)
+{
+    if (guard_mode != GUARD_BAND_OFF && !outline_in_guard(screen, n))
+    {
+        if (guard_mode == GUARD_BAND_CLIP)
+        {
+            if (poly->parent->flags & OBJ_FLAG_GUARD_CLIP)
+            {
+                n = clip_outline_to_guard(screen, n);
+                poly->screen_clipped = TRUE;
+            }
+            else if (!outline_overlaps_guard(screen, n))
+            {
+                n = 0;
+            }
+        }
+
+        if (guard_mode == GUARD_BAND_REJECT || n < 3)
+        {
+            render_stats.polys_guard_rejected++;
+            return(FALSE);
+        }
+
+        render_stats.polys_guard_clipped++;
+    }
+
+    map_outline(poly, screen, n);
+
+    return(TRUE);
+}
+
+// Gather corners from the object's screen buffer
+static Boolean poly_from_cache(polygon_typ_ptr poly)
+{
+    Point screen[CLIP_MAX_VERTS];
+    Point *verts = poly->parent->screen_verts;
+
+    screen[0] = verts[ poly->vertex_lut[0] ];
+    screen[1] = verts[ poly->vertex_lut[1] ];
+    screen[2] = verts[ poly->vertex_lut[2] ];
+    screen[3] = verts[ poly->vertex_lut[3] ];
+
+    poly->screen_clipped = FALSE;
+
+    return(map_poly_screen(poly, screen, 4));
+}
+
+/*  Cut a polygon that straddles the near plane and map its CCB to the part in front.
+    Level cels are a single color, so squeezing the whole cel into the clipped outline draws correctly. */
+static Boolean map_clipped_poly(polygon_typ_ptr poly, vec3f16 *cam, int32 near)
+{
+    uint32 n;
+    vec3f16 clipped[CLIP_MAX_VERTS];
+    Point screen[CLIP_MAX_VERTS];
+
+    n = clip_poly_near(poly, cam, near, clipped);
+
+    if (n < 3)
+        return(FALSE);
+
+    fix_project_points_f16(screen, clipped, n, VIEW_DIST_SHIFT, near, display_width2_f16, display_height2_f16);
+
+    poly->screen_clipped = TRUE;
+
+    return(map_poly_screen(poly, screen, n));
+}
+
+// Index of the edge between vertices a and b, added if it is not in the set yet
+static uint16 find_edge(object_typ_ptr obj, uint32 a, uint32 b)
+{
+    uint32 i;
+    uint32 temp;
+
+    if (a == b)
+        return(EDGE_NONE);
+
+    if (a > b)
+    {
+        temp = a;
+        a = b;
+        b = temp;
+    }
+
+    for (i = 0; i < obj->edge_count; i++)
+    {
+        if (obj->edges[i].a == a && obj->edges[i].b == b)
+            return((uint16) i);
+    }
+
+    obj->edges[i].a = (uint16) a;
+    obj->edges[i].b = (uint16) b;
+    obj->edges[i].stamp = 0;
+    obj->edge_count++;
+
+    return((uint16) i);
+}
+
+static void free_obj_edges(object_typ_ptr obj)
+{
+    if (obj->edges)
+        FreeMem(obj->edges, sizeof(edge_typ) * obj->poly_count * 4);
+
+    obj->edges = NULL;
+    obj->edge_count = 0;
+}
+
+// Draw the sides of poly not already drawn this wireframe frame
+static void draw_poly_edges(polygon_typ_ptr poly, GrafCon *gcon)
+{
+    uint32 k;
+    edge_typ_ptr edge;
+    Point *screen = poly->parent->screen_verts;
+
+    for (k = 0; k < 4; k++)
+    {
+        if (poly->edge_lut[k] == EDGE_NONE)
+            continue;
+
+        edge = &poly->parent->edges[ poly->edge_lut[k] ];
+
+        if (edge->stamp == wire_frame)
+            continue;
+
+        edge->stamp = wire_frame;
+
+        gcon->gc_PenX = screen[edge->a].pt_X >> FRACBITS_16;
+        gcon->gc_PenY = screen[edge->a].pt_Y >> FRACBITS_16;
+
+        DrawTo(sc->sc_BitmapItems[sc->sc_CurrentScreen], gcon, 
+            screen[edge->b].pt_X >> FRACBITS_16, screen[edge->b].pt_Y >> FRACBITS_16);
+    }
+}
 
-/* *************************************************************************************** */
-/* ================================== PRIVATE VARS ======================================= */
-/* *************************************************************************************** */
+static void save_sort_order(void)
+{
+    uint32 i;
 
-static polygon_typ_ptr poly_list[MAX_POLY_RASTER];
-static uint32 poly_list_size = 0;
+    if (++sort_frame == 0)
+        sort_frame = 1; // Zero marks polygons that were never sorted
 
-// This is very specific to level logic
-static int32 inv_depth_table[Z_LUT_SIZE];
+    for (i = 0; i < poly_queue.size; i++)
+    {
+        poly_queue.items[i]->sort_rank = i;
+        poly_queue.items[i]->sort_stamp = sort_frame;
+    }
+
+    sort_prev_size = poly_queue.size;
+}
 
 /* *************************************************************************************** */
 /* ========================== PUBLIC FUNCTION DEFINITIONS ================================ */
@@ -44,14 +850,16 @@ void poly_to_world_cam(polygon_typ_ptr poly)
 {
     uint32 i;
     vertex_typ_ptr vtyp;
+    vec3f16 local;
 
     for (i = 0; i < 4; i++)
     {
         // World
         vtyp = &poly->parent->vertex_def.vertices[poly->vertex_lut[i]];
-        poly->world[i][0] = vtyp->vertex[VERTEX_X] + poly->parent->world_x;
-        poly->world[i][1] = vtyp->vertex[VERTEX_Y] + poly->parent->world_y;
-        poly->world[i][2] = vtyp->vertex[VERTEX_Z] + poly->parent->world_z;
+        rotate_obj_vector(poly->parent, local, vtyp->vertex);
+        poly->world[i][0] = local[VERTEX_X] + poly->parent->world_x;
+        poly->world[i][1] = local[VERTEX_Y] + poly->parent->world_y;
+        poly->world[i][2] = local[VERTEX_Z] + poly->parent->world_z;
 
         // Cam
         poly->camera[i][0] = poly->world[i][0] - camera.world_x;
@@ -66,14 +874,16 @@ Boolean poly_to_world_cam_clip(polygon_typ_ptr poly, int32 near)
 {
     uint32 i, j;
     vertex_typ_ptr vtyp;
+    vec3f16 local;
 
     for (i = 0, j = 0; i < 4; i++)
     {
          // World
         vtyp = &poly->parent->vertex_def.vertices[poly->vertex_lut[i]];
-        poly->world[i][VERTEX_X] = vtyp->vertex[VERTEX_X] + poly->parent->world_x;
-        poly->world[i][VERTEX_Y] = vtyp->vertex[VERTEX_Y] + poly->parent->world_y;
-        poly->world[i][VERTEX_Z] = vtyp->vertex[VERTEX_Z] + poly->parent->world_z;
+        rotate_obj_vector(poly->parent, local, vtyp->vertex);
+        poly->world[i][VERTEX_X] = local[VERTEX_X] + poly->parent->world_x;
+        poly->world[i][VERTEX_Y] = local[VERTEX_Y] + poly->parent->world_y;
+        poly->world[i][VERTEX_Z] = local[VERTEX_Z] + poly->parent->world_z;
 
         // Cam
         poly->camera[i][VERTEX_X] = poly->world[i][0] - camera.world_x;
@@ -134,8 +944,8 @@ void poly_to_screen(polygon_typ_ptr poly, Boolean use_inv_lut)
             if (poly->camera[i][VERTEX_Z] < 0)
                 lut_value = -lut_value; // Go back to negative if needed
 
-            poly->screen[i].pt_X = MulSF16(poly->camera[i][VERTEX_X] << VIEW_DIST_SHIFT, lut_value) + display_width2_f16;
-            poly->screen[i].pt_Y = MulSF16(-poly->camera[i][VERTEX_Y] << VIEW_DIST_SHIFT, lut_value) + display_height2_f16;
+            poly->screen[i].pt_X = FIX_MUL(poly->camera[i][VERTEX_X] << VIEW_DIST_SHIFT, lut_value) + display_width2_f16;
+            poly->screen[i].pt_Y = FIX_MUL(-poly->camera[i][VERTEX_Y] << VIEW_DIST_SHIFT, lut_value) + display_height2_f16;
 
             // Test clamping to reduce lag
             #if 0
@@ -156,8 +966,8 @@ void poly_to_screen(polygon_typ_ptr poly, Boolean use_inv_lut)
             if (z == 0) 
                 z = 1;
 
-            poly->screen[i].pt_X = DivSF16(poly->camera[i][VERTEX_X] << VIEW_DIST_SHIFT, z) + display_width2_f16;
-            poly->screen[i].pt_Y = DivSF16(-poly->camera[i][VERTEX_Y] << VIEW_DIST_SHIFT, z) + display_height2_f16;
+            poly->screen[i].pt_X = FIX_DIV(poly->camera[i][VERTEX_X] << VIEW_DIST_SHIFT, z) + display_width2_f16;
+            poly->screen[i].pt_Y = FIX_DIV(-poly->camera[i][VERTEX_Y] << VIEW_DIST_SHIFT, z) + display_height2_f16;
         }
     }
 
@@ -191,15 +1001,49 @@ void point_to_screen(Point *dest, vec3f16 point, Boolean use_inv_lut)
         if (point[2] < 0)
             lut_value = -lut_value; // Go back to negative if needed
 
-        dest->pt_X = ( MulSF16(point[0] << VIEW_DIST_SHIFT, lut_value) >> FRACBITS_16 ) + display_width2;
-        dest->pt_Y = ( MulSF16(-point[1] << VIEW_DIST_SHIFT, lut_value) >> FRACBITS_16 ) + display_height2;
+        dest->pt_X = ( FIX_MUL(point[0] << VIEW_DIST_SHIFT, lut_value) >> FRACBITS_16 ) + display_width2;
+        dest->pt_Y = ( FIX_MUL(-point[1] << VIEW_DIST_SHIFT, lut_value) >> FRACBITS_16 ) + display_height2;
     }
     else 
     {
         if (z == 0) z = 1;
 
-        dest->pt_X = ( DivSF16(point[0] << VIEW_DIST_SHIFT, z) >> FRACBITS_16 ) + display_width2;
-        dest->pt_Y = ( DivSF16(-point[1] << VIEW_DIST_SHIFT, z) >> FRACBITS_16 ) + display_height2;
+        dest->pt_X = ( FIX_DIV(point[0] << VIEW_DIST_SHIFT, z) >> FRACBITS_16 ) + display_width2;
+        dest->pt_Y = ( FIX_DIV(-point[1] << VIEW_DIST_SHIFT, z) >> FRACBITS_16 ) + display_height2;
+    }
+}
+
+void points_to_screen(Point *dest, vec3f16 *points, int32 count, int32 near)
+{
+    int32 cam_x, cam_y, cam_z;
+    int32 z;
+    int32 lut_index;
+    int32 lut_value;
+
+    cam_x = camera.world_x;
+    cam_y = camera.world_y;
+    cam_z = camera.world_z;
+
+    while (count-- > 0)
+    {
+        z = (*points)[2] - cam_z;
+
+        if (z < near)
+            z = near;
+
+        // Z should be within the range 0 - 16
+        lut_index = CAM_Z_TO_LUT(z);
+
+        if (lut_index < 0) lut_index = 0;
+        else if (lut_index >= Z_LUT_SIZE) lut_index = Z_LUT_SIZE - 1;
+
+        lut_value = inv_depth_table[lut_index];
+
+        dest->pt_X = ( FIX_MUL(((*points)[0] - cam_x) << VIEW_DIST_SHIFT, lut_value) >> FRACBITS_16 ) + display_width2;
+        dest->pt_Y = ( FIX_MUL(-((*points)[1] - cam_y) << VIEW_DIST_SHIFT, lut_value) >> FRACBITS_16 ) + display_height2;
+
+        points++;
+        dest++;
     }
 }
 
@@ -233,7 +1077,7 @@ void calc_poly_normal(polygon_typ_ptr poly)
 
     vector3_from_points(vec2, p2, p1);
 
-    Cross3_F16(poly->normal, vec2, vec1);
+    FIX_CROSS3(poly->normal, vec2, vec1);
 
     normalize_vector3(poly->normal);
 }
@@ -251,12 +1095,15 @@ void scale_obj(object_typ_ptr obj, int32 scale_factor)
     {
         // MulScalarF16() 
 
-        vtyp->vertex[VERTEX_X] = MulSF16(vtyp->vertex[VERTEX_X], scale_factor);
-        vtyp->vertex[VERTEX_Y] = MulSF16(vtyp->vertex[VERTEX_Y], scale_factor);
-        vtyp->vertex[VERTEX_Z] = MulSF16(vtyp->vertex[VERTEX_Z], scale_factor);
+        vtyp->vertex[VERTEX_X] = FIX_MUL(vtyp->vertex[VERTEX_X], scale_factor);
+        vtyp->vertex[VERTEX_Y] = FIX_MUL(vtyp->vertex[VERTEX_Y], scale_factor);
+        vtyp->vertex[VERTEX_Z] = FIX_MUL(vtyp->vertex[VERTEX_Z], scale_factor);
 
         vtyp++; // Next
     }
+
+    obj->shape_version++;
+    MARK_OBJ_DIRTY(obj);
 }
 
 void scale_obj_x(object_typ_ptr obj, int32 scale_factor)
@@ -272,10 +1119,13 @@ void scale_obj_x(object_typ_ptr obj, int32 scale_factor)
     {
         // MulScalarF16() 
 
-        vtyp->vertex[VERTEX_X] = MulSF16(vtyp->vertex[VERTEX_X], scale_factor);
+        vtyp->vertex[VERTEX_X] = FIX_MUL(vtyp->vertex[VERTEX_X], scale_factor);
 
         vtyp++; // Next
     }
+
+    obj->shape_version++;
+    MARK_OBJ_DIRTY(obj);
 }
 
 void scale_obj_y(object_typ_ptr obj, int32 scale_factor)
@@ -291,10 +1141,13 @@ void scale_obj_y(object_typ_ptr obj, int32 scale_factor)
     {
         // MulScalarF16() 
 
-        vtyp->vertex[VERTEX_Y] = MulSF16(vtyp->vertex[VERTEX_Y], scale_factor);
+        vtyp->vertex[VERTEX_Y] = FIX_MUL(vtyp->vertex[VERTEX_Y], scale_factor);
 
         vtyp++; // Next
     }
+
+    obj->shape_version++;
+    MARK_OBJ_DIRTY(obj);
 }
 
 object_typ_ptr load_obj(char *file_path)
@@ -304,6 +1157,9 @@ object_typ_ptr load_obj(char *file_path)
 
     obj = (object_typ_ptr) AllocMem(sizeof(object_typ), MEMTYPE_DRAM);
     memset((void*)obj, 0, sizeof(object_typ));
+    obj->version = 1; // Normals have not been calculated yet
+    obj->shape_version = 1; // Culling has not measured a radius yet
+    identity_matrix(obj->rotation);
 
     if (load_resource(file_path, REZ_FILE, &rez_envelope) >= 0)
     {
@@ -322,6 +1178,8 @@ object_typ_ptr load_obj(char *file_path)
             seek_rez_data(&rez_envelope, &obj->vertex_def.vertices[i].vertex[VERTEX_Z]);
         }
 
+        alloc_obj_vertex_cache(obj);
+
         obj->polygons = (polygon_typ_ptr) AllocMem(sizeof(polygon_typ) * obj->poly_count, MEMTYPE_DRAM);
 
         for (i = 0; i < obj->poly_count; i++)
@@ -333,10 +1191,16 @@ object_typ_ptr load_obj(char *file_path)
             seek_rez_data(&rez_envelope, (int32*) &obj->polygons[i].vertex_lut[3]);
 
             obj->polygons[i].ccb = 0;
+            obj->polygons[i].sort_stamp = 0;
+            obj->polygons[i].clip_piece = NULL;
+            obj->polygons[i].clip_split = FALSE;
+            obj->polygons[i].screen_clipped = FALSE;
 
             obj->polygons[i].parent = obj;
         }
 
+        build_obj_edges(obj);
+
         unload_resource(&rez_envelope, REZ_FILE);
 
         #if DEBUG_MODE 
@@ -364,12 +1228,23 @@ void unload_obj(object_typ_ptr obj)
     if (!obj)
         return;
 
+    // Freed CCBs may come back at the same addresses
+    links_valid = FALSE;
+
+    free_obj_edges(obj);
+
     if (obj->vertex_def.vertex_count > 0)
     {
         if (obj->vertex_def.vertices)
         {
             FreeMem(obj->vertex_def.vertices, sizeof(vertex_typ) * obj->vertex_def.vertex_count);
         }
+
+        if (obj->camera_verts)
+            FreeMem(obj->camera_verts, sizeof(vec3f16) * obj->vertex_def.vertex_count);
+
+        if (obj->screen_verts)
+            FreeMem(obj->screen_verts, sizeof(Point) * obj->vertex_def.vertex_count);
     }
 
     if (obj->vertex_def_copy.vertex_count > 0)
@@ -394,6 +1269,8 @@ void unload_obj(object_typ_ptr obj)
                 {
                     DeleteCel(poly->ccb);
                 }
+
+                free_clip_piece(poly);
                 poly++;
             }
 
@@ -410,6 +1287,13 @@ void copy_vertex_def(vertex_def_typ_ptr dest, vertex_def_typ_ptr source)
     memcpy((void*)dest->vertices, (void*)source->vertices, nbytes);    
 }
 
+void reset_obj_vertices(object_typ_ptr obj, vertex_def_typ_ptr source)
+{
+    copy_vertex_def(&obj->vertex_def, source);
+    obj->shape_version++;
+    MARK_OBJ_DIRTY(obj);
+}
+
 void clone_vertex_def(vertex_def_typ_ptr dest, vertex_def_typ_ptr source)
 {
     uint32 nbytes = sizeof(vertex_typ) * source->vertex_count;
@@ -420,28 +1304,102 @@ void clone_vertex_def(vertex_def_typ_ptr dest, vertex_def_typ_ptr source)
 
 int32 add_obj_zclip(object_typ_ptr obj, int32 near)
 {
-    uint32 i;
+    uint32 i, j, k;
+    Boolean backface_cull;
+    int32 z;
+    int32 sumz;
+    vec3f16 *cam;
     polygon_typ_ptr poly;
 
-    // Check if poly fits
-    if ((poly_list_size + obj->poly_count > MAX_POLY_RASTER) || poly_list_size >= MAX_POLY_RASTER)
-        return(-1);
+    if (!obj_in_frustum(obj, near))
+    {
+        render_stats.objs_culled++;
+        return(0);
+    }
+
+    render_stats.objs_drawn++;
 
     poly = obj->polygons;
     i = obj->poly_count;
 
+    sync_camera_version();
+
+    if (obj_cache_valid(obj, CACHE_MODE_ZCLIP, near))
+    {
+        // Screen corners and CCBs still hold last frame's values, clipped ones included
+        while (i--)
+        {
+            if (poly->cache_queued)
+            {
+                rqueue_push(&poly_queue, poly);
+                render_stats.polys_reused++;
+            }
+
+            ++poly;
+        }
+
+        render_stats.polys_backfaced += obj->cache_backfaced;
+
+        return(0);
+    }
+
+    backface_cull = (obj->flags & OBJ_FLAG_BACKFACE_CULL) ? TRUE : FALSE;
+
+    if (backface_cull)
+        sync_obj_normals(obj);
+
+    obj_to_camera(obj);
+    obj_to_screen_clip(obj, near);
+    save_obj_cache(obj, CACHE_MODE_ZCLIP, near);
+
+    obj->cache_backfaced = 0;
+    cam = obj->camera_verts;
+
     while (i--)
     {
-        if (poly_to_world_cam_clip(poly, near))
+        for (k = 0, j = 0, sumz = 0; k < 4; k++)
+        {
+            z = cam[ poly->vertex_lut[k] ][VERTEX_Z];
+
+            if (z < near)
+            {
+                z = near;
+                j++;
+            }
+
+            sumz += z;
+        }
+
+        // Queue only if one or more polygon vertices are in front of the camera
+        poly->cache_queued = (j < 4);
+
+        if (poly->cache_queued && backface_cull && is_backface(poly, cam))
+        {
+            poly->cache_queued = FALSE;
+            obj->cache_backfaced++;
+        }
+
+        if (poly->cache_queued)
+        {
+            poly->avgz = sumz >> 2;
+
+            if (j > 0)
+                render_stats.polys_clipped++;
+
+            poly->cache_queued = (j == 0) ? poly_from_cache(poly) : map_clipped_poly(poly, cam, near);
+        }
+
+        if (poly->cache_queued)
         {
-            // One or more polygon vertices are in front of the camera
-            poly_to_screen(poly, FALSE);
-            poly_list[poly_list_size++] = poly;    
+            rqueue_push(&poly_queue, poly);    
+            render_stats.polys_recomputed++;
         }
        
         ++poly;
     }
 
+    render_stats.polys_backfaced += obj->cache_backfaced;
+
     return(0);
 }
 
@@ -449,114 +1407,177 @@ int32 add_obj(object_typ_ptr obj, Boolean use_inv_lut)
 {
     uint32 i = obj->poly_count;
     polygon_typ_ptr poly = obj->polygons;
+    vec3f16 *cam;
+    Boolean backface_cull;
+    int32 mode = use_inv_lut ? CACHE_MODE_LUT : CACHE_MODE_DIV;
+
+    if (!obj_in_frustum(obj, 0))
+    {
+        render_stats.objs_culled++;
+        return(0);
+    }
+
+    render_stats.objs_drawn++;
+
+    sync_camera_version();
+
+    if (obj_cache_valid(obj, mode, 0))
+    {
+        // Screen corners and CCBs still hold last frame's values
+        while (i--)
+        {
+            if (poly->cache_queued)
+            {
+                rqueue_push(&poly_queue, poly);
+                render_stats.polys_reused++;
+            }
+
+            ++poly;
+        }
+
+        render_stats.polys_backfaced += obj->cache_backfaced;
+
+        return(0);
+    }
 
-    // Check if poly fits
-    if ((poly_list_size + obj->poly_count > MAX_POLY_RASTER) || poly_list_size >= MAX_POLY_RASTER)
-        return(-1);
+    backface_cull = (obj->flags & OBJ_FLAG_BACKFACE_CULL) ? TRUE : FALSE;
+
+    if (backface_cull)
+        sync_obj_normals(obj);
+
+    obj_to_camera(obj);
+    obj_to_screen(obj, use_inv_lut);
+    save_obj_cache(obj, mode, 0);
+
+    obj->cache_backfaced = 0;
+    cam = obj->camera_verts;
 
     while (i--)
     {
-        poly_to_world_cam(poly);
-        poly_to_screen(poly, use_inv_lut);
-        poly_list[poly_list_size++] = poly;     
+        if (backface_cull && is_backface(poly, cam))
+        {
+            poly->cache_queued = FALSE;
+            obj->cache_backfaced++;
+        }
+        else 
+        {
+            poly->avgz = (cam[poly->vertex_lut[0]][VERTEX_Z] + cam[poly->vertex_lut[1]][VERTEX_Z] + 
+                cam[poly->vertex_lut[2]][VERTEX_Z] + cam[poly->vertex_lut[3]][VERTEX_Z]) >> 2;
+
+            poly->cache_queued = poly_from_cache(poly);
+        }
+
+        if (poly->cache_queued)
+        {
+            rqueue_push(&poly_queue, poly);     
+            render_stats.polys_recomputed++;
+        }
+
         ++poly;
     }
 
+    render_stats.polys_backfaced += obj->cache_backfaced;
+
     return(0);
 }
 
 void begin_3d(void)
 {
-    poly_list_size = 0;
+    rqueue_reset(&poly_queue);
+    render_stats.polys_reused = 0;
+    render_stats.polys_recomputed = 0;
+    render_stats.objs_culled = 0;
+    render_stats.objs_drawn = 0;
+    render_stats.polys_backfaced = 0;
+    render_stats.polys_clipped = 0;
+    render_stats.polys_guard_clipped = 0;
+    render_stats.polys_guard_rejected = 0;
 }
 
 void end_3d(void)
 {
-    int32 i;
-    
-    if (poly_list_size > 0)
-    {
-        // Link cels 
+    uint32 i;
+    CCB *ccb;
+    CCB *next;
 
-        for (i = 0; i < poly_list_size-1; i++)
-        {
-            LINK_CEL(poly_list[i]->ccb, poly_list[i+1]->ccb);
-            UNLAST_CEL(poly_list[i]->ccb);
-        }
+    rqueue_pack(&poly_queue);
 
-        LAST_CEL(poly_list[poly_list_size-1]->ccb);
+    render_stats.polys_dropped = poly_queue.dropped;
+    render_stats.queue_high_water = poly_queue.high_water;
+    render_stats.links_rewritten = 0;
+
+    if (poly_queue.size == 0)
+    {
+        dlist_set_layer(DLIST_LAYER_3D, NULL, NULL);
+        linked_size = 0;
+        return;
     }
-}
 
-void sort_polys(void)
-{
-    uint32 i, j;
-    polygon_typ_ptr temp;
+    /*  A link is still in place if the same two CCBs were neighbours last frame. The last
+        CCB is excluded since the display list points it at the next layer. */
 
-    for (i = 0; i < poly_list_size; i++)
+    for (i = 0; i < poly_queue.size - 1; i++)
     {
-        for (j = 0; j < poly_list_size-1; j++)
+        ccb = poly_queue.items[i]->ccb;
+        next = poly_queue.items[i+1]->ccb;
+
+        if (!links_valid || i + 1 >= linked_size || linked_ccbs[i] != ccb || linked_ccbs[i+1] != next)
         {
-            if (poly_list[j]->avgz < poly_list[j+1]->avgz)
-            {
-                temp = poly_list[j];
-                poly_list[j] = poly_list[j+1];
-                poly_list[j+1] = temp;
-            }
+            LINK_CEL(ccb, next);
+            UNLAST_CEL(ccb);
+            render_stats.links_rewritten++;
         }
     }
+
+    for (i = 0; i < poly_queue.size; i++)
+        linked_ccbs[i] = poly_queue.items[i]->ccb;
+
+    linked_size = poly_queue.size;
+    links_valid = TRUE;
+
+    dlist_set_layer(DLIST_LAYER_3D, linked_ccbs[0], linked_ccbs[linked_size-1]);
 }
 
-void raster_scene(CCB *bg_start, CCB *bg_end, CCB *fg_start)
+void sort_polys(void)
 {
-    CCB *first = NULL;
+    rqueue_pack(&poly_queue);
 
-    if (poly_list_size > 0)
-    {
-        if (bg_start)
-        {
-            first = bg_start;
-            UNLAST_CEL(bg_end);
-            LINK_CEL(bg_end, poly_list[0]->ccb);
+    if (poly_queue.size < 2)
+        return;
 
-            if (fg_start)
-            {
-                UNLAST_CEL(poly_list[poly_list_size-1]->ccb);
-                LINK_CEL(poly_list[poly_list_size-1]->ccb, fg_start);
-            }           
-        }
-        else 
-        {
-            first = poly_list[0]->ccb;
+    if (!reuse_sort_order())
+        bucket_sort_polys();
 
-            if (fg_start)
-            {
-                UNLAST_CEL(poly_list[poly_list_size-1]->ccb);
-                LINK_CEL(poly_list[poly_list_size-1]->ccb, fg_start);
-            }
-        }
-    }
-    else 
-    {
-        if (fg_start)
-            first = fg_start;
-    }
+    insertion_sort_polys();
+    save_sort_order();
+}
 
-    if (first)
-        DrawCels(sc->sc_BitmapItems[sc->sc_CurrentScreen], first);
+void raster_scene(void)
+{
+    dlist_draw(sc->sc_BitmapItems[sc->sc_CurrentScreen]);
 }
 
 void raster_scene_wireframe(uint32 color, CCB *fg)
 {
-    polygon_typ_ptr *poly_pp;
+    static GrafCon gcon;
+    polygon_typ_ptr poly;
     uint32 i;
 
-    poly_pp = poly_list;
+    if (++wire_frame == 0)
+        wire_frame = 1; // Zero marks edges that were never drawn
+
+    SetFGPen(&gcon, color);
+    rqueue_pack(&poly_queue);
 
-    for (i = 0; i < poly_list_size; i++)
+    for (i = 0; i < poly_queue.size; i++)
     {
-        draw_poly_wireframe(*poly_pp, color);
-        ++poly_pp;
+        poly = poly_queue.items[i];
+
+        // Clipped outlines have corners of their own
+        if (poly->screen_clipped || !poly->parent->edges)
+            draw_poly_wireframe(poly, color);
+        else 
+            draw_poly_edges(poly, &gcon);
     }
 
     if (fg)
@@ -590,6 +1611,7 @@ void draw_poly_normal(Item bitmap_item, polygon_typ_ptr poly)
     static Boolean first_run = TRUE;
     vec3f16 pos;
     vec3f16 normal;
+    vec3f16 *cam;
     Coord start_x, start_y;
     Coord end_x, end_y;
 
@@ -600,21 +1622,24 @@ void draw_poly_normal(Item bitmap_item, polygon_typ_ptr poly)
     }
 
     // Scale normal for display purposes
-    normal[0] = MulSF16(poly->normal[0], 16384); // x
-    normal[1] = MulSF16(poly->normal[1], 16384); // y
-    normal[2] = MulSF16(poly->normal[2], 16384); // z
+    normal[0] = FIX_MUL(poly->normal[0], 16384); // x
+    normal[1] = FIX_MUL(poly->normal[1], 16384); // y
+    normal[2] = FIX_MUL(poly->normal[2], 16384); // z
+    rotate_obj_vector(poly->parent, normal, normal);
 
     // Draw normal from center of poly
 
-    pos[0] = (poly->world[0][0] + poly->world[2][0]) / 2 - camera.world_x;
-    pos[1] = (poly->world[0][1] + poly->world[2][1]) / 2 - camera.world_y;
-    pos[2] = (poly->world[0][2] + poly->world[2][2]) / 2 - camera.world_z;
+    cam = poly->parent->camera_verts;
+
+    pos[0] = (cam[poly->vertex_lut[0]][0] + cam[poly->vertex_lut[2]][0]) / 2;
+    pos[1] = (cam[poly->vertex_lut[0]][1] + cam[poly->vertex_lut[2]][1]) / 2;
+    pos[2] = (cam[poly->vertex_lut[0]][2] + cam[poly->vertex_lut[2]][2]) / 2;
 
     if (pos[2] == 0)
         pos[2] = 1;
 
-    start_x = ( DivSF16(pos[0] << VIEW_DIST_SHIFT, pos[2]) >> FRACBITS_16 ) + display_width2;
-    start_y = ( DivSF16(-pos[1] << VIEW_DIST_SHIFT, pos[2]) >> FRACBITS_16 ) + display_height2;
+    start_x = ( FIX_DIV(pos[0] << VIEW_DIST_SHIFT, pos[2]) >> FRACBITS_16 ) + display_width2;
+    start_y = ( FIX_DIV(-pos[1] << VIEW_DIST_SHIFT, pos[2]) >> FRACBITS_16 ) + display_height2;
 
     // Project normal endpoint in 3D
 
@@ -627,8 +1652,8 @@ void draw_poly_normal(Item bitmap_item, polygon_typ_ptr poly)
 
     // Convert endpoint to screen space
 
-    end_x = ( DivSF16(pos[0] << VIEW_DIST_SHIFT, pos[2]) >> FRACBITS_16 ) + display_width2;
-    end_y = ( DivSF16(-pos[1] << VIEW_DIST_SHIFT, pos[2]) >> FRACBITS_16 ) + display_height2;
+    end_x = ( FIX_DIV(pos[0] << VIEW_DIST_SHIFT, pos[2]) >> FRACBITS_16 ) + display_width2;
+    end_y = ( FIX_DIV(-pos[1] << VIEW_DIST_SHIFT, pos[2]) >> FRACBITS_16 ) + display_height2;
 
     gcon.gc_PenX = start_x;
     gcon.gc_PenY = start_y;
@@ -646,226 +1671,84 @@ void draw_obj_normals(Item bitmap_item, object_typ_ptr obj)
 
 void rotate_obj(object_typ_ptr obj, vec3f16 angles)
 {
-    uint32 flags;
-    int32 i;
-    frac16 cs, sn;
-    mat33f16 rotx;
-    mat33f16 roty;
-    mat33f16 rotz;
-    mat33f16 temp;
     mat33f16 rotation;
-    vec3f16 transform;
-    vertex_typ_ptr vtyp;
-    
-    flags = 0;
-
-    if (angles[0])
-    {
-        // x rotation
-        flags |= 1;
-
-        identity_matrix(rotx);
-        cs = CosF16(angles[0]);
-        sn = SinF16(angles[0]);
-        rotx[1][1] = cs;
-        rotx[1][2] = -sn;
-        rotx[2][1] = sn;
-        rotx[2][2] = cs;
-    }
-
-    if (angles[1])
-    {
-        // y rotation
-        flags |= 2;
-
-        identity_matrix(roty);
-        cs = CosF16(angles[1]);
-        sn = SinF16(angles[1]);       
-        roty[0][0] = cs;
-        roty[0][2] = sn;
-        roty[2][0] = -sn;
-        roty[2][2] = cs;
-    }
-
-    if (angles[2])
-    {
-        // z rotation
-        flags |= 4;
-
-        identity_matrix(rotz);
-        cs = CosF16(angles[2]);
-        sn = SinF16(angles[2]);
-        rotz[0][0] = cs;
-        rotz[0][1] = -sn;
-        rotz[1][0] = sn;
-        rotz[1][1] = cs;
-    }
-
-    if (flags)
-    {
-        switch (flags)
-        {
-            case 1: // x rot only
-                COPY_MAT33F16(rotation, rotx);
-                break;
-            case 2: // y rot only
-                COPY_MAT33F16(rotation, roty);
-                break;
-            case 4: // z rot only
-                COPY_MAT33F16(rotation, rotz);
-                break;
-            case 3: // x and y rot 
-                MulMat33Mat33_F16(rotation, rotx, roty);
-                break;
-            case 6: // y and z rot 
-                MulMat33Mat33_F16(rotation, roty, rotz);
-                break;
-            case 7: // x y z rot 
-                MulMat33Mat33_F16(temp, rotx, roty);
-                MulMat33Mat33_F16(rotation, temp, rotz);
-                break;
-            default:
-                break;
-        }
 
-        /*  Update vertices. Note, this will impact all meshes using the same vertex def.
-            If you want to isolate this, give the object its own deep copy. */
-
-        vtyp = obj->vertex_def.vertices; // First
+    if (angles[0] == 0 && angles[1] == 0 && angles[2] == 0)
+        return;
 
-        i = obj->vertex_def.vertex_count;
-        
-        while (i--)
-        {
-            transform[0] = vtyp->vertex[VERTEX_X];
-            transform[1] = vtyp->vertex[VERTEX_Y];
-            transform[2] = vtyp->vertex[VERTEX_Z];
-            
-            MulVec3Mat33_F16(vtyp->vertex, transform, rotation);
+    /*  Vertices are left untouched. The rotation is composed with the object's 
+        matrix and applied during projection. */
 
-            vtyp++; // Next vertex
-        }
-    }
+    build_euler_matrix(rotation, angles);
+    compose_obj_rotation(obj, rotation);
 }
 
 void rotate_obj4_z(object_typ_ptr obj, int32 angle)
 {
     mat33f16 rotz;
     frac16 cs, sn;
-    vec3f16 source_verts[4];
-    vec3f16 dest_verts[4];
-
-    cs = CosF16(angle);
-    sn = SinF16(angle);
-
-    identity_matrix(rotz);
-    rotz[0][0] = cs;
-    rotz[0][1] = -sn;
-    rotz[1][0] = sn;
-    rotz[1][1] = cs;
-
-    // No loops to squeeze performance
-
-    source_verts[0][VERTEX_X] = obj->vertex_def.vertices[0].vertex[VERTEX_X];
-    source_verts[0][VERTEX_Y] = obj->vertex_def.vertices[0].vertex[VERTEX_Y];
-    source_verts[0][VERTEX_Z] = obj->vertex_def.vertices[0].vertex[VERTEX_Z];
-
-    source_verts[1][VERTEX_X] = obj->vertex_def.vertices[1].vertex[VERTEX_X];
-    source_verts[1][VERTEX_Y] = obj->vertex_def.vertices[1].vertex[VERTEX_Y];
-    source_verts[1][VERTEX_Z] = obj->vertex_def.vertices[1].vertex[VERTEX_Z];
-
-    source_verts[2][VERTEX_X] = obj->vertex_def.vertices[2].vertex[VERTEX_X];
-    source_verts[2][VERTEX_Y] = obj->vertex_def.vertices[2].vertex[VERTEX_Y];
-    source_verts[2][VERTEX_Z] = obj->vertex_def.vertices[2].vertex[VERTEX_Z];
 
-    source_verts[3][VERTEX_X] = obj->vertex_def.vertices[3].vertex[VERTEX_X];
-    source_verts[3][VERTEX_Y] = obj->vertex_def.vertices[3].vertex[VERTEX_Y];
-    source_verts[3][VERTEX_Z] = obj->vertex_def.vertices[3].vertex[VERTEX_Z];
+    sincos_f16(angle, &sn, &cs);
+    build_z_matrix(rotz, sn, cs);
 
-    MulManyVec3Mat33_F16(dest_verts, source_verts, rotz, 4);
-
-    obj->vertex_def.vertices[0].vertex[VERTEX_X] = dest_verts[0][VERTEX_X];
-    obj->vertex_def.vertices[0].vertex[VERTEX_Y] = dest_verts[0][VERTEX_Y];
-    obj->vertex_def.vertices[0].vertex[VERTEX_Z] = dest_verts[0][VERTEX_Z];
-
-    obj->vertex_def.vertices[1].vertex[VERTEX_X] = dest_verts[1][VERTEX_X];
-    obj->vertex_def.vertices[1].vertex[VERTEX_Y] = dest_verts[1][VERTEX_Y];
-    obj->vertex_def.vertices[1].vertex[VERTEX_Z] = dest_verts[1][VERTEX_Z];
-
-    obj->vertex_def.vertices[2].vertex[VERTEX_X] = dest_verts[2][VERTEX_X];
-    obj->vertex_def.vertices[2].vertex[VERTEX_Y] = dest_verts[2][VERTEX_Y];
-    obj->vertex_def.vertices[2].vertex[VERTEX_Z] = dest_verts[2][VERTEX_Z];
-
-    obj->vertex_def.vertices[3].vertex[VERTEX_X] = dest_verts[3][VERTEX_X];
-    obj->vertex_def.vertices[3].vertex[VERTEX_Y] = dest_verts[3][VERTEX_Y];
-    obj->vertex_def.vertices[3].vertex[VERTEX_Z] = dest_verts[3][VERTEX_Z];
+    compose_obj_rotation(obj, rotz);
 }
 
 void rotate_obj_pivot_z(object_typ_ptr obj, vec3f16 pivot, int32 angle)
 {
-    uint32 i;
-    int32 cs, sn;
-    vertex_typ_ptr vtyp;
+    frac16 cs, sn;
     vec3f16 transform;
     mat33f16 rotz;
 
-    vtyp = obj->vertex_def.vertices; // First
-
-    i = obj->vertex_def.vertex_count;
+    sincos_f16(angle, &sn, &cs);
+    build_z_matrix(rotz, sn, cs);
     
-    identity_matrix(rotz);
-    cs = CosF16(angle);
-    sn = SinF16(angle);
-    rotz[0][0] = cs;
-    rotz[0][1] = -sn;
-    rotz[1][0] = sn;
-    rotz[1][1] = cs;
-    
-    // Rotate verts 
-
-    while (i--)
-    {
-        // Convert vertex to world space and subtract pivot point.
-        transform[VERTEX_X] = vtyp->vertex[VERTEX_X] + obj->world_x - pivot[VERTEX_X];
-        transform[VERTEX_Y] = vtyp->vertex[VERTEX_Y] + obj->world_y - pivot[VERTEX_Y];
-        transform[VERTEX_Z] = vtyp->vertex[VERTEX_Z] + obj->world_z - pivot[VERTEX_Z];
-        
-        // Rotate 
-        MulVec3Mat33_F16(vtyp->vertex, transform, rotz);
-
-        // Add pivot back
-        vtyp->vertex[VERTEX_X] += pivot[VERTEX_X];// - obj->world_x;
-        vtyp->vertex[VERTEX_Y] += pivot[VERTEX_Y];// - obj->world_y;
-        vtyp->vertex[VERTEX_Z] += pivot[VERTEX_Z];// - obj->world_z;
-
-        vtyp++; // Next vertex
-    }
-
-    // Rotate center to keep object intact
+    // Rotate center around the pivot, the object's own rotation takes care of the vertices
     
     transform[VERTEX_X] = obj->world_x - pivot[VERTEX_X];
     transform[VERTEX_Y] = obj->world_y - pivot[VERTEX_Y];
     transform[VERTEX_Z] = obj->world_z - pivot[VERTEX_Z];
 
-    MulVec3Mat33_F16(transform, transform, rotz);
+    FIX_MUL_VEC3_MAT33(transform, transform, rotz);
 
     obj->world_x = transform[VERTEX_X] + pivot[VERTEX_X];
     obj->world_y = transform[VERTEX_Y] + pivot[VERTEX_Y];
     obj->world_z = transform[VERTEX_Z] + pivot[VERTEX_Z];
 
-    // Convert verts back to local space
+    compose_obj_rotation(obj, rotz);
+}
 
-    vtyp = obj->vertex_def.vertices; // First
+void reset_obj_rotation(object_typ_ptr obj)
+{
+    identity_matrix(obj->rotation);
+    obj->rotated = FALSE;
+    MARK_OBJ_DIRTY(obj);
+}
 
-    i = obj->vertex_def.vertex_count;
+void set_obj_rotation_z(object_typ_ptr obj, frac16 sn, frac16 cs)
+{
+    build_z_matrix(obj->rotation, sn, cs);
+    obj->rotated = TRUE;
+    MARK_OBJ_DIRTY(obj);
+}
 
-    while (i--)
-    {
-        vtyp->vertex[VERTEX_X] -= obj->world_x;
-        vtyp->vertex[VERTEX_Y] -= obj->world_y;
-        vtyp->vertex[VERTEX_Z] -= obj->world_z;
+void rotate_obj_vector(object_typ_ptr obj, vec3f16 dest, vec3f16 source)
+{
+    vec3f16 temp;
+
+    temp[VERTEX_X] = source[VERTEX_X];
+    temp[VERTEX_Y] = source[VERTEX_Y];
+    temp[VERTEX_Z] = source[VERTEX_Z];
 
-        vtyp++; // Next vertex
+    if (obj->rotated)
+    {
+        FIX_MUL_VEC3_MAT33(dest, temp, obj->rotation);
+    }
+    else 
+    {
+        dest[VERTEX_X] = temp[VERTEX_X];
+        dest[VERTEX_Y] = temp[VERTEX_Y];
+        dest[VERTEX_Z] = temp[VERTEX_Z];
     }
 }
 
@@ -876,17 +1759,28 @@ object_typ_ptr copy_obj(object_typ_ptr source)
 
     dest = (object_typ_ptr) AllocMem(sizeof(object_typ), MEMTYPE_DRAM);
     memset((void*)dest, 0, sizeof(object_typ));
+    dest->version = 1;
+    dest->flags = source->flags;
+    dest->priority = source->priority;
+    dest->rotated = source->rotated;
+    COPY_MAT33F16(dest->rotation, source->rotation);
 
     dest->vertex_def.vertex_count = source->vertex_def.vertex_count;
     dest->vertex_def.vertices = (vertex_typ_ptr) AllocMem(sizeof(vertex_typ) * source->vertex_def.vertex_count, MEMTYPE_DRAM);
     memcpy((void*)dest->vertex_def.vertices, (void*)source->vertex_def.vertices, sizeof(vertex_typ) * source->vertex_def.vertex_count);
 
+    alloc_obj_vertex_cache(dest);
+
     dest->poly_count = source->poly_count;
     dest->polygons = (polygon_typ_ptr) AllocMem(sizeof(polygon_typ) * source->poly_count, MEMTYPE_DRAM);
 
     for (i = 0; i < source->poly_count; i++)
     {
         dest->polygons[i].parent = dest;
+        dest->polygons[i].sort_stamp = 0;
+        dest->polygons[i].clip_piece = NULL;
+        dest->polygons[i].clip_split = FALSE;
+        dest->polygons[i].screen_clipped = FALSE;
         memcpy((void*)dest->polygons[i].vertex_lut, (void*)source->polygons[i].vertex_lut, (sizeof(uint32) * 4));
         memcpy((void*)dest->polygons[i].normal, (void*)source->polygons[i].normal, sizeof(vec3f16));
 
@@ -894,9 +1788,28 @@ object_typ_ptr copy_obj(object_typ_ptr source)
         dest->polygons[i].ccb = create_coded_cel8(source->polygons[i].ccb->ccb_Width, source->polygons[i].ccb->ccb_Height, FALSE);
         dest->polygons[i].ccb->ccb_SourcePtr = source->polygons[i].ccb->ccb_SourcePtr;
         dest->polygons[i].ccb->ccb_PLUTPtr = source->polygons[i].ccb->ccb_PLUTPtr;
+        memcpy((void*)dest->polygons[i].edge_lut, (void*)source->polygons[i].edge_lut, (sizeof(uint16) * 4));
+    }
+
+    // Same sides as the source, with draw stamps of its own
+    if (source->edges)
+    {
+        dest->edges = (edge_typ_ptr) AllocMem(sizeof(edge_typ) * dest->poly_count * 4, MEMTYPE_DRAM);
+
+        if (dest->edges)
+        {
+            memcpy((void*)dest->edges, (void*)source->edges, sizeof(edge_typ) * source->edge_count);
+            dest->edge_count = source->edge_count;
+
+            for (i = 0; i < dest->edge_count; i++)
+                dest->edges[i].stamp = 0;
+        }
     }
 
     dest->bsphere_radius = source->bsphere_radius;
+    dest->cull_radius = source->cull_radius;
+    dest->cull_version = source->cull_version;
+    dest->shape_version = source->shape_version;
 
     return(dest);
 }
@@ -936,18 +1849,18 @@ void print_obj(object_typ_ptr obj)
 
 void normalize_vector(vec3f16 vec)
 {
-    int32 mag = SqrtF16(SquareSF16(vec[0]) + SquareSF16(vec[1]) + SquareSF16(vec[2]));
+    int32 mag = FIX_SQRT(FIX_SQUARE(vec[0]) + FIX_SQUARE(vec[1]) + FIX_SQUARE(vec[2]));
 
     if (mag == 0) mag = 1;
     
-    vec[0] = DivSF16(vec[0], mag);
-    vec[1] = DivSF16(vec[1], mag);
-    vec[2] = DivSF16(vec[2], mag);
+    vec[0] = FIX_DIV(vec[0], mag);
+    vec[1] = FIX_DIV(vec[1], mag);
+    vec[2] = FIX_DIV(vec[2], mag);
 }
 
 int32 get_vector_magnitude(vec3f16 vec)
 {
-    int32 mag = SqrtF16(SquareSF16(vec[0]) + SquareSF16(vec[1]) + SquareSF16(vec[2]));
+    int32 mag = FIX_SQRT(FIX_SQUARE(vec[0]) + FIX_SQUARE(vec[1]) + FIX_SQUARE(vec[2]));
     return(mag);    
 }
 
@@ -980,7 +1893,7 @@ uint32 calc_bsphere_radius(object_typ_ptr obj)
         y = obj->vertex_def.vertices[i].vertex[VERTEX_Y];
         z = obj->vertex_def.vertices[i].vertex[VERTEX_Z];
 
-        next_radius = SqrtF16(SquareSF16(x) + SquareSF16(y) + SquareSF16(z));
+        next_radius = FIX_SQRT(FIX_SQUARE(x) + FIX_SQUARE(y) + FIX_SQUARE(z));
        
         if (next_radius > radius)
             radius = next_radius;
@@ -1009,8 +1922,8 @@ Boolean is_colliding(object_typ_ptr obj1, object_typ_ptr obj2, Boolean half)
         r2 = r2 >> 1;
     }
 
-    squared_dist = SquareSF16(a) + SquareSF16(b) + SquareSF16(c);
-    squared_radius = SquareSF16(r1 + r2);
+    squared_dist = FIX_SQUARE(a) + FIX_SQUARE(b) + FIX_SQUARE(c);
+    squared_radius = FIX_SQUARE(r1 + r2);
 
     if (squared_radius >= squared_dist)
         return(TRUE);
@@ -1022,12 +1935,39 @@ void init_3d(void)
 {
     uint32 i;
     uint32 value = 512;
+    frac16 slope, len;
 
     for (i = 0; i < Z_LUT_SIZE; i++)
     {
-        inv_depth_table[i] = DivSF16(ONE_F16, value);
+        inv_depth_table[i] = FIX_DIV(ONE_F16, value);
         value += 512;
     }
+
+    // Side planes pass through the eye and the screen edges at the view distance
+    
+    slope = FIX_DIV(display_width2_f16, ONE_F16 << VIEW_DIST_SHIFT);
+    len = FIX_SQRT(ONE_F16 + FIX_SQUARE(slope));
+    frustum_x_nx = FIX_DIV(ONE_F16, len);
+    frustum_x_nz = FIX_DIV(slope, len);
+
+    slope = FIX_DIV(display_height2_f16, ONE_F16 << VIEW_DIST_SHIFT);
+    len = FIX_SQRT(ONE_F16 + FIX_SQUARE(slope));
+    frustum_y_ny = FIX_DIV(ONE_F16, len);
+    frustum_y_nz = FIX_DIV(slope, len);
+
+    set_guard_band(guard_mode, GUARD_BAND_MARGIN);
+}
+
+void set_guard_band(uint32 mode, int32 margin)
+{
+    guard_mode = mode;
+    guard_left = -margin << FRACBITS_16;
+    guard_top = -margin << FRACBITS_16;
+    guard_right = ((int32) display_width + margin) << FRACBITS_16;
+    guard_bottom = ((int32) display_height + margin) << FRACBITS_16;
+
+    // Cached screen corners were built with the old band
+    camera.version++;
 }
 
 void translate_obj(object_typ_ptr obj, vec3f16 transform)
@@ -1050,4 +1990,31 @@ void calc_obj_normals(object_typ_ptr obj)
 
     for (i = 0; i < obj->poly_count; i++)
         calc_poly_normal(&obj->polygons[i]);
+
+    obj->normals_version = obj->version;
+}
+
+void build_obj_edges(object_typ_ptr obj)
+{
+    uint32 i, k;
+    polygon_typ_ptr poly;
+
+    // Worst case every side is unique
+    obj->edges = (edge_typ_ptr) AllocMem(sizeof(edge_typ) * obj->poly_count * 4, MEMTYPE_DRAM);
+    obj->edge_count = 0;
+
+    if (!obj->edges)
+    {
+        #if DEBUG_MODE
+            printf("Error - could not allocate edge set.\n");
+        #endif
+
+        return;
+    }
+
+    for (i = 0, poly = obj->polygons; i < obj->poly_count; i++, poly++)
+    {
+        for (k = 0; k < 4; k++)
+            poly->edge_lut[k] = find_edge(obj, poly->vertex_lut[k], poly->vertex_lut[(k + 1) & 3]);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "trig.h"
+#include "trig_lut.h"
+
+/* *************************************************************************************** */
+/* ================================ CONSTANTS / TYPES ==================================== */
+/* *************************************************************************************** */
+
+#define TRIG_ANG_256 16777216
+#define TRIG_ANG_128 8388608
+#define TRIG_ANG_64 4194304
+#define TRIG_ANG_MASK (TRIG_ANG_256 - 1)
+#define TRIG_QUARTER_MASK (TRIG_ANG_64 - 1)
+#define SIN_SHIFT (24 - TRIG_LUT_BITS)     // Angle bits below one table step
+#define ATAN_SHIFT (16 - ATAN_LUT_BITS)    // Ratio bits below one table step
+
+/* *************************************************************************************** */
+/* ========================== PRIVATE FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+// pos is 0 - 64.0, interpolates between table steps
+static frac16 quarter_sin(int32 pos)
+{
+    int32 index = pos >> SIN_SHIFT;
+    int32 frac = pos & ((1 << SIN_SHIFT) - 1);
+
+    if (index >= SIN_LUT_SIZE - 1)
+        return(sin_lut[SIN_LUT_SIZE - 1]);
+
+    return(sin_lut[index] + (((sin_lut[index + 1] - sin_lut[index]) * frac) >> SIN_SHIFT));
+}
+
+/* *************************************************************************************** */
+/* =========================== PUBLIC FUNCTION DEFINITIONS =============================== */
+/* *************************************************************************************** */
+
+frac16 sin_f16(frac16 angle)
+{
+    int32 quadrant;
+    int32 pos;
+    frac16 value;
+
+    angle &= TRIG_ANG_MASK;
+    quadrant = angle >> 22;
+    pos = angle & TRIG_QUARTER_MASK;
+
+    // Second and fourth quadrants mirror the first
+    if (quadrant & 1)
+        pos = TRIG_ANG_64 - pos;
+
+    value = quarter_sin(pos);
+
+    return((quadrant & 2) ? -value : value);
+}
+
+frac16 cos_f16(frac16 angle)
+{
+    return(sin_f16(angle + TRIG_ANG_64));
+}
+
+void sincos_f16(frac16 angle, frac16 *sn, frac16 *cs)
+{
+    *sn = sin_f16(angle);
+    *cs = sin_f16(angle + TRIG_ANG_64);
+}
+
+frac16 atan2_f16(frac16 x, frac16 y)
+{
+    int32 ax, ay, temp;
+    int32 ratio, index, frac;
+    int32 angle;
+    Boolean swap;
+
+    ax = (x < 0) ? -x : x;
+    ay = (y < 0) ? -y : y;
+
+    if (ax == 0 && ay == 0)
+        return(0);
+
+    // Reduce to the first octant so the ratio stays within 0 - 1
+    swap = (ay > ax);
+
+    if (swap)
+    {
+        temp = ax;
+        ax = ay;
+        ay = temp;
+    }
+
+    // Keep ay << 16 within 32 bits
+    while (ay >= 32768)
+    {
+        ax >>= 1;
+        ay >>= 1;
+    }
+
+    ratio = (ay << 16) / ax;
+    index = ratio >> ATAN_SHIFT;
+    frac = ratio & ((1 << ATAN_SHIFT) - 1);
+
+    if (index >= ATAN_LUT_SIZE - 1)
+        angle = atan_lut[ATAN_LUT_SIZE - 1];
+    else 
+        angle = atan_lut[index] + (((atan_lut[index + 1] - atan_lut[index]) * frac) >> ATAN_SHIFT);
+
+    if (swap)
+        angle = TRIG_ANG_64 - angle;
+
+    if (x < 0)
+        angle = TRIG_ANG_128 - angle;
+
+    if (y < 0)
+        angle = TRIG_ANG_256 - angle;
+
+    return(angle & TRIG_ANG_MASK);
+}
@@ -0,0 +1,64 @@
+'''
+    Pulls a frame capture out of a debug console log.
+
+    Usage:
+        python capture_extract.py log_file [out_file]
+
+    The game prints the capture with capture_dump() as CAPF lines. Each word is
+    written back big endian, which gives the same bytes the console had in memory.
+    out_file defaults to frame_<frame>.capf next to the log. Load the result on a
+    host build with capture_read() and capture_replay() from source/capture.c.
+'''
+
+import sys
+import os
+import struct
+
+# start
+
+if len(sys.argv) < 2:
+    print("Error - Missing log file")
+    sys.exit()
+
+words = []
+size = 0
+frame = 0
+cost = 0
+inside = False
+
+with open(sys.argv[1], "r") as fin:
+    for line in fin:
+        parts = line.split()
+
+        if len(parts) < 2 or parts[0] != "CAPF":
+            continue
+
+        if parts[1] == "BEGIN":
+            # Only the last capture in the log is kept
+            words = []
+            size, frame, cost = int(parts[2]), int(parts[3]), int(parts[4])
+            inside = True
+        elif parts[1] == "END":
+            inside = False
+        elif parts[1] == "NONE":
+            print("Error - The game had no frame captured")
+            sys.exit()
+        elif inside:
+            if int(parts[1], 16) != len(words) * 4:
+                print(f"Error - Line at offset {parts[1]} is out of order, the log may have dropped lines")
+                sys.exit()
+            words.extend(int(w, 16) for w in parts[2:])
+
+if len(words) * 4 != size or size == 0:
+    print(f"Error - Expected {size} bytes but found {len(words) * 4}")
+    sys.exit()
+
+if len(sys.argv) > 2:
+    out_file = sys.argv[2]
+else:
+    out_file = os.path.join(os.path.dirname(os.path.abspath(sys.argv[1])), f"frame_{frame}.capf")
+
+with open(out_file, "wb") as fout:
+    fout.write(struct.pack(f">{len(words)}I", *words))
+
+print(f"Frame {frame}, cost {cost}, {size} bytes written to {out_file}")
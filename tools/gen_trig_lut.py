@@ -0,0 +1,159 @@
+'''
+    Generates the sine and arctangent tables used by source/trig.c.
+
+    Usage:
+        python gen_trig_lut.py [trig_bits] [atan_bits]
+
+    trig_bits is log2 of sine entries per full turn (6 - 14, default 10).
+    atan_bits is log2 of arctangent entries over one octant (6 - 12, default 8).
+
+    Writes source/trig_lut.c and source/includes/trig_lut.h, then prints the
+    worst error of the C lookup against the exact result rounded to 16.16, which
+    is what the math folio returns. The C kernels are mirrored below step for step.
+
+    build_host.sh checks the generated tables against results logged from the
+    folio on a console and reports calls per second, see tools/host/trig_check.c.
+'''
+
+import sys
+import os
+import math
+
+# 2^16 for 3DO's 16.16 format
+FRACBITS_16 = pow(2, 16)
+
+# 3DO angles, 256.0 is a full turn
+ANG_256 = pow(2, 24)
+ANG_64 = pow(2, 22)
+ANG_32 = pow(2, 21)
+
+# helpers
+
+def to_f16(value):
+    return int(round(value * FRACBITS_16))
+
+def c_div(a, b):
+    # C integer division truncates toward zero
+    q = abs(a) // abs(b)
+    return q if (a >= 0) == (b >= 0) else -q
+
+def write_table(fout, name, values):
+    fout.write(f"const frac16 {name}[{len(values)}] = \n{{\n")
+    for i in range(0, len(values), 8):
+        row = ", ".join(str(v) for v in values[i:i + 8])
+        fout.write(f"    {row}{',' if i + 8 < len(values) else ''}\n")
+    fout.write("};\n")
+
+# mirrors of the C kernels
+
+def quarter_sin(sin_lut, shift, pos):
+    index = pos >> shift
+    if index >= len(sin_lut) - 1:
+        return sin_lut[-1]
+    frac = pos & ((1 << shift) - 1)
+    return sin_lut[index] + (((sin_lut[index + 1] - sin_lut[index]) * frac) >> shift)
+
+def lut_sin(sin_lut, shift, angle):
+    angle &= ANG_256 - 1
+    quadrant = angle >> 22
+    pos = angle & (ANG_64 - 1)
+    if quadrant & 1:
+        pos = ANG_64 - pos
+    value = quarter_sin(sin_lut, shift, pos)
+    return -value if quadrant & 2 else value
+
+def lut_atan2(atan_lut, atan_bits, x, y):
+    ax = abs(x)
+    ay = abs(y)
+    if ax == 0 and ay == 0:
+        return 0
+    swap = ay > ax
+    if swap:
+        ax, ay = ay, ax
+    while ay >= 32768:
+        ax >>= 1
+        ay >>= 1
+    ratio = c_div(ay << 16, ax)
+    shift = 16 - atan_bits
+    index = ratio >> shift
+    frac = ratio & ((1 << shift) - 1)
+    if index >= len(atan_lut) - 1:
+        angle = atan_lut[-1]
+    else:
+        angle = atan_lut[index] + (((atan_lut[index + 1] - atan_lut[index]) * frac) >> shift)
+    if swap:
+        angle = ANG_64 - angle
+    if x < 0:
+        angle = (ANG_256 >> 1) - angle
+    if y < 0:
+        angle = ANG_256 - angle
+    return angle & (ANG_256 - 1)
+
+# start
+
+trig_bits = int(sys.argv[1]) if len(sys.argv) > 1 else 10
+atan_bits = int(sys.argv[2]) if len(sys.argv) > 2 else 8
+
+if trig_bits < 6 or trig_bits > 14 or atan_bits < 6 or atan_bits > 12:
+    print("Error - trig_bits must be 6 - 14 and atan_bits 6 - 12")
+    sys.exit()
+
+quarter = pow(2, trig_bits - 2)
+trig_shift = 24 - trig_bits
+sin_lut = [to_f16(math.sin(i * math.pi / 2 / quarter)) for i in range(quarter + 1)]
+
+octant = pow(2, atan_bits)
+atan_lut = [int(round(math.atan(i / octant) * ANG_256 / (2 * math.pi))) for i in range(octant + 1)]
+
+source_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "source")
+
+with open(os.path.join(source_dir, "includes", "trig_lut.h"), "w") as fout:
+    fout.write("// Generated by tools/gen_trig_lut.py, do not edit.\n\n")
+    fout.write("#ifndef TRIG_LUT_H\n#define TRIG_LUT_H\n\n")
+    fout.write("#include \"types.h\"\n#include \"operamath.h\"\n\n")
+    fout.write(f"#define TRIG_LUT_BITS {trig_bits}".ljust(28) + "// Sine entries per full turn, as a power of 2\n")
+    fout.write(f"#define ATAN_LUT_BITS {atan_bits}".ljust(28) + "// Arctangent entries per octant, as a power of 2\n")
+    fout.write(f"#define SIN_LUT_SIZE {quarter + 1}".ljust(28) + "// Quarter wave plus the end point\n")
+    fout.write(f"#define ATAN_LUT_SIZE {octant + 1}\n\n")
+    fout.write("extern const frac16 sin_lut[SIN_LUT_SIZE];\n")
+    fout.write("extern const frac16 atan_lut[ATAN_LUT_SIZE];\n\n")
+    fout.write("#endif // TRIG_LUT_H\n")
+
+with open(os.path.join(source_dir, "trig_lut.c"), "w") as fout:
+    fout.write("// Generated by tools/gen_trig_lut.py, do not edit.\n\n")
+    fout.write("#include \"trig_lut.h\"\n\n")
+    fout.write("// sin over a quarter turn, 16.16\n")
+    write_table(fout, "sin_lut", sin_lut)
+    fout.write("\n// atan over ratios 0 - 1, in angle units where 256.0 is a full turn\n")
+    write_table(fout, "atan_lut", atan_lut)
+
+print(f"{len(sin_lut)} sine entries, {len(atan_lut)} arctangent entries written")
+
+# accuracy report
+
+max_sin_err = 0
+max_cos_err = 0
+for angle in range(0, ANG_256, 61):
+    expected = to_f16(math.sin(angle * 2 * math.pi / ANG_256))
+    max_sin_err = max(max_sin_err, abs(lut_sin(sin_lut, trig_shift, angle) - expected))
+    expected = to_f16(math.cos(angle * 2 * math.pi / ANG_256))
+    max_cos_err = max(max_cos_err, abs(lut_sin(sin_lut, trig_shift, angle + ANG_64) - expected))
+
+max_atan_err = 0
+samples = [v * FRACBITS_16 // 64 for v in range(-2048, 2049, 7)]
+for x in samples:
+    for y in samples:
+        if x == 0 and y == 0:
+            continue
+        expected = int(round(math.atan2(y, x) * ANG_256 / (2 * math.pi))) & (ANG_256 - 1)
+        err = abs(lut_atan2(atan_lut, atan_bits, x, y) - expected)
+        max_atan_err = max(max_atan_err, min(err, ANG_256 - err))
+
+print(f"sin max error  {max_sin_err} / 65536 ({max_sin_err / FRACBITS_16:.6f})")
+print(f"cos max error  {max_cos_err} / 65536 ({max_cos_err / FRACBITS_16:.6f})")
+print(f"atan2 max error {max_atan_err} angle units ({max_atan_err * 360.0 / ANG_256:.4f} degrees)")
+
+# Each lookup is one masked shift, two table reads and one multiply. The folio
+# calls go through the math folio vector on every call.
+print(f"cost per sin/cos: 2 table reads, 1 multiply, table {len(sin_lut) * 4} bytes")
+print(f"cost per atan2: 1 divide, 2 table reads, 1 multiply, table {len(atan_lut) * 4} bytes")
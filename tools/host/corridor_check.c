@@ -0,0 +1,294 @@
+/**
+ * @file corridor_check.c
+ * @brief Checks the corridor occupancy index kept by corridors.c.
+ *
+ * Levels are loaded from the CD directory and the enemy code runs on them
+ * unchanged. After every step the index must agree with the enemies and spikes
+ * themselves: each corridor lists exactly the live enemies on it, holds the
+ * spike on it, and get_free_corridor only hands out corridors with neither.
+ *
+ * Enemies are spawned until every corridor is taken, then left to walk, roll
+ * and side step between corridors, zapped and destroyed, and finally cleared.
+ * Build with MAX_ENEMIES and MAX_SPIKES raised so the corridors can be filled.
+ */
+
+#include "host_play.h"
+
+#define FRAME_MSEC 16
+#define FRAME_DELTA 256         // delta_time passed to update_enemies, fast enough to reach the rim
+#define FILL_FRAMES 4000
+#define MOVE_FRAMES 600
+#define FREE_PICKS 32           // get_free_corridor calls per corridor, enough to see every free one
+
+static uint32 last_corridors[MAX_ENEMIES];
+static uint32 corridor_moves = 0;
+static int failures = 0;
+
+static uint32 lowest_corridor(uint32 bits)
+{
+    uint32 i = 0;
+
+    while (!(bits & 1))
+    {
+        bits >>= 1;
+        ++i;
+    }
+
+    return(i);
+}
+
+static void fail(const char *phase, const char *what, uint32 corridor)
+{
+    if (failures < 20)
+        printf("FAIL %s: corridor %u %s\n", phase, (unsigned int) corridor, what);
+
+    failures++;
+}
+
+// Corridors with a live enemy or an active spike, as the index should see them
+static uint32 expected_taken(uint32 corridor_count)
+{
+    uint32 taken = 0;
+    uint32 i;
+
+    for (i = 0; i < MAX_ENEMIES; i++)
+    {
+        if (enemies[i].state != ES_INACTIVE)
+            taken |= 1 << enemies[i].corridor_index;
+    }
+
+    for (i = 0; i < MAX_SPIKES; i++)
+    {
+        if (spikes[i].active)
+            taken |= 1 << spikes[i].corridor_index;
+    }
+
+    return(taken & ((1 << corridor_count) - 1));
+}
+
+static void check_lists(const char *phase, uint32 corridor_count)
+{
+    enemy_typ_ptr enemy;
+    spike_typ_ptr spike;
+    uint32 i, listed = 0, live = 0, length;
+
+    for (i = 0; i < corridor_count; i++)
+    {
+        length = 0;
+
+        for (enemy = get_corridor_enemy(i); enemy; enemy = get_next_corridor_enemy(enemy))
+        {
+            if (enemy->state == ES_INACTIVE)
+                fail(phase, "lists an inactive enemy", i);
+            else if (enemy->corridor_index != i)
+                fail(phase, "lists an enemy from another corridor", i);
+
+            if (++length > MAX_ENEMIES)
+            {
+                fail(phase, "enemy list does not end", i);
+                break;
+            }
+        }
+
+        listed += length;
+        spike = get_corridor_spike(i);
+
+        if (spike && (!spike->active || spike->corridor_index != i))
+            fail(phase, "holds a spike that is not on it", i);
+    }
+
+    for (i = 0; i < MAX_ENEMIES; i++)
+    {
+        if (enemies[i].state != ES_INACTIVE)
+            ++live;
+    }
+
+    for (i = 0; i < MAX_SPIKES; i++)
+    {
+        if (spikes[i].active && get_corridor_spike(spikes[i].corridor_index) != &spikes[i])
+            fail(phase, "lost its spike", spikes[i].corridor_index);
+    }
+
+    if (listed != live)
+    {
+        printf("FAIL %s: %u enemies listed, %u live\n", phase, (unsigned int) listed, (unsigned int) live);
+        failures++;
+    }
+}
+
+static void check_free(const char *phase, uint32 corridor_count)
+{
+    uint32 free = ~expected_taken(corridor_count) & ((1 << corridor_count) - 1);
+    uint32 seen = 0;
+    uint32 i, pick;
+
+    for (i = 0; i < FREE_PICKS * corridor_count; i++)
+    {
+        pick = get_free_corridor();
+
+        if (pick == CORRIDOR_NONE)
+        {
+            if (free)
+                fail(phase, "is free but get_free_corridor found none", lowest_corridor(free));
+
+            return;
+        }
+
+        if (pick >= corridor_count || !(free & (1 << pick)))
+        {
+            fail(phase, "was handed out while taken", pick);
+            return;
+        }
+
+        seen |= 1 << pick;
+    }
+
+    if (seen != free)
+        fail(phase, "is free but never handed out", lowest_corridor(free & ~seen));
+}
+
+static void check_step(const char *phase, uint32 corridor_count)
+{
+    uint32 i;
+
+    for (i = 0; i < MAX_ENEMIES; i++)
+    {
+        if (enemies[i].state == ES_ACTIVE && last_corridors[i] != CORRIDOR_NONE &&
+            last_corridors[i] != enemies[i].corridor_index)
+        {
+            ++corridor_moves;
+        }
+
+        last_corridors[i] = (enemies[i].state == ES_INACTIVE) ? CORRIDOR_NONE : enemies[i].corridor_index;
+    }
+
+    check_lists(phase, corridor_count);
+    check_free(phase, corridor_count);
+}
+
+static void step_frame(void)
+{
+    host_msec += FRAME_MSEC;
+    update_enemies(FRAME_DELTA);
+}
+
+static void check_level(uint32 number)
+{
+    level_typ_ptr level = host_load_level(number);
+    uint32 count, frame, i;
+    uint32 all;
+
+    if (!level)
+    {
+        failures++;
+        return;
+    }
+
+    count = level->obj->poly_count;
+    all = (1 << count) - 1;
+
+    // Every enemy type may spawn
+    current_level = 99;
+    corridor_moves = 0;
+
+    clear_hostiles();
+
+    for (i = 0; i < MAX_ENEMIES; i++)
+        last_corridors[i] = CORRIDOR_NONE;
+
+    check_step("clear", count);
+
+    for (frame = 0; frame < FILL_FRAMES && expected_taken(count) != all; frame++)
+    {
+        spawn_next_enemy();
+        check_step("spawn", count);
+        step_frame();
+        check_step("spawn update", count);
+    }
+
+    if (expected_taken(count) != all)
+    {
+        printf("FAIL level %u: corridors not filled after %u frames\n", (unsigned int) number, (unsigned int) frame);
+        failures++;
+    }
+
+    check_free("full", count);
+
+    // Flippers roll and fuseballs side step along the rim
+    for (frame = 0; frame < MOVE_FRAMES; frame++)
+    {
+        step_frame();
+        check_step("move", count);
+    }
+
+    if (corridor_moves == 0)
+    {
+        printf("FAIL level %u: no enemy changed corridor\n", (unsigned int) number);
+        failures++;
+    }
+
+    // Zapped enemies stay listed until their animation ends
+    zap_enemies();
+    check_step("zap", count);
+
+    for (frame = 0; frame < 64; frame++)
+    {
+        host_msec += 200;
+        update_enemies(0);
+        check_step("zap update", count);
+    }
+
+    for (i = 0; i < MAX_ENEMIES; i++)
+    {
+        if (enemies[i].state != ES_INACTIVE)
+            fail("zap", "kept a zapped enemy", enemies[i].corridor_index);
+    }
+
+    // Shoot down every spike
+    for (frame = 0; frame < 16; frame++)
+    {
+        for (i = 0; i < MAX_SPIKES; i++)
+        {
+            if (spikes[i].active)
+                damage_spike(&spikes[i]);
+        }
+
+        check_step("destroy spikes", count);
+    }
+
+    // Refill, then clear enemies alone, then everything
+    for (frame = 0; frame < 200; frame++)
+    {
+        spawn_next_enemy();
+        step_frame();
+    }
+
+    check_step("refill", count);
+    clear_enemies();
+    check_step("clear enemies", count);
+    clear_hostiles();
+    check_step("clear hostiles", count);
+
+    if (expected_taken(count) != 0 || get_free_corridor() == CORRIDOR_NONE)
+    {
+        printf("FAIL level %u: corridors still taken after clear_hostiles\n", (unsigned int) number);
+        failures++;
+    }
+
+    printf("corridors: level %u, %u corridors, %u corridor changes\n", (unsigned int) number,
+        (unsigned int) count, (unsigned int) corridor_moves);
+}
+
+int main(void)
+{
+    srand(1);
+    init_enemies();
+
+    check_level(1);     // Open
+    check_level(5);     // Wraps
+    check_level(20);
+
+    printf("corridors: %s\n", failures ? "FAILED" : "ok");
+
+    return(failures != 0);
+}
@@ -0,0 +1,106 @@
+/**
+ * @file edges_check.c
+ * @brief Checks the shared edge sets built by build_obj_edges.
+ *
+ * Builds small meshes in memory, runs build_obj_edges and copy_obj on them and
+ * checks the edge count and that every polygon side maps to the edge joining
+ * its two corners.
+ */
+
+#include "threed.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static int failures = 0;
+
+// Unit cube, every side is shared by exactly two faces
+static uint32 cube_faces[6][4] = 
+{
+    { 0, 1, 2, 3 }, { 4, 7, 6, 5 }, { 0, 4, 5, 1 }, 
+    { 1, 5, 6, 2 }, { 2, 6, 7, 3 }, { 3, 7, 4, 0 }
+};
+
+// 2 x 2 grid of quads on a 3 x 3 vertex grid, plus a triangle with a doubled corner adding one side
+static uint32 grid_faces[5][4] = 
+{
+    { 0, 1, 4, 3 }, { 1, 2, 5, 4 }, { 3, 4, 7, 6 }, { 4, 5, 8, 7 }, { 0, 3, 6, 6 }
+};
+
+static object_typ_ptr make_obj(uint32 vertex_count, uint32 (*faces)[4], uint32 poly_count)
+{
+    object_typ_ptr obj = (object_typ_ptr) AllocMem(sizeof(object_typ), MEMTYPE_FILL);
+    uint32 i;
+
+    obj->version = 1;
+    obj->vertex_def.vertex_count = vertex_count;
+    obj->vertex_def.vertices = (vertex_typ_ptr) AllocMem(sizeof(vertex_typ) * vertex_count, MEMTYPE_FILL);
+    obj->poly_count = poly_count;
+    obj->polygons = (polygon_typ_ptr) AllocMem(sizeof(polygon_typ) * poly_count, MEMTYPE_FILL);
+
+    for (i = 0; i < poly_count; i++)
+    {
+        memcpy(obj->polygons[i].vertex_lut, faces[i], sizeof(uint32) * 4);
+        obj->polygons[i].parent = obj;
+        obj->polygons[i].ccb = CreateCel(1, 1, 8, CREATECEL_CODED, NULL);
+    }
+
+    build_obj_edges(obj);
+
+    return(obj);
+}
+
+static void check_obj(const char *name, object_typ_ptr obj, uint32 want_edges)
+{
+    uint32 i, k, a, b;
+    polygon_typ_ptr poly;
+    edge_typ_ptr edge;
+
+    if (obj->edge_count != want_edges)
+    {
+        printf("FAIL %s: %u edges, want %u\n", name, (unsigned int) obj->edge_count, (unsigned int) want_edges);
+        failures++;
+    }
+
+    for (i = 0, poly = obj->polygons; i < obj->poly_count; i++, poly++)
+    {
+        for (k = 0; k < 4; k++)
+        {
+            a = poly->vertex_lut[k];
+            b = poly->vertex_lut[(k + 1) & 3];
+
+            if (a == b)
+            {
+                if (poly->edge_lut[k] != EDGE_NONE)
+                {
+                    printf("FAIL %s: polygon %u side %u should have no edge\n", name, (unsigned int) i, (unsigned int) k);
+                    failures++;
+                }
+
+                continue;
+            }
+
+            edge = &obj->edges[ poly->edge_lut[k] ];
+
+            if (!((edge->a == a && edge->b == b) || (edge->a == b && edge->b == a)))
+            {
+                printf("FAIL %s: polygon %u side %u maps to the wrong edge\n", name, (unsigned int) i, (unsigned int) k);
+                failures++;
+            }
+        }
+    }
+}
+
+int main(void)
+{
+    object_typ_ptr cube = make_obj(8, cube_faces, 6);
+    object_typ_ptr grid = make_obj(9, grid_faces, 5);
+
+    check_obj("cube", cube, 12);
+    check_obj("grid", grid, 13);
+    check_obj("cube copy", copy_obj(cube), 12);
+
+    printf("edges: %s\n", failures ? "FAILED" : "ok");
+
+    return(failures != 0);
+}
@@ -0,0 +1,186 @@
+/**
+ * @file euler_check.c
+ * @brief Checks the rotation rotate_obj builds against the chained axis matrices and times both.
+ *
+ * rotate_obj writes rotx * roty * rotz in one pass. Before that it built each
+ * single axis matrix and multiplied them together. Starting from an unrotated
+ * object, rotate_obj leaves its matrix in the object, so that matrix is compared
+ * against the product for every combination of zero and nonzero angles. The two
+ * round differently, so entries may differ by a few bits. Single axes must match
+ * exactly.
+ *
+ * Finally rotate_obj on a fresh object is timed against building and chaining
+ * the three matrices the old way.
+ */
+
+#include "threed.h"
+#include "maths.h"
+#include "trig.h"
+#include "fixmath.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define CHECK_ANGLES 4096
+#define MAX_ERROR 4             // 16.16 units, the fused matrix rounds once less per entry
+#define BENCH_SECONDS 0.25
+#define BENCH_CALLS 256         // Matrices built between clock checks
+
+static object_typ obj;
+static uint32 seed = 12345;
+static int32 worst = 0;
+static int failures = 0;
+
+static int32 next_random(int32 range)
+{
+    seed = seed * 1664525 + 1013904223;
+    return((int32) ((seed >> 8) % (uint32) range));
+}
+
+// rotate_obj before the fused matrix, with every axis chained
+static void chained_matrix(mat33f16 rotation, vec3f16 angles)
+{
+    mat33f16 rotx, roty, rotz, temp;
+    frac16 cs, sn;
+
+    identity_matrix(rotx);
+    sincos_f16(angles[0], &sn, &cs);
+    rotx[1][1] = cs;
+    rotx[1][2] = -sn;
+    rotx[2][1] = sn;
+    rotx[2][2] = cs;
+
+    identity_matrix(roty);
+    sincos_f16(angles[1], &sn, &cs);
+    roty[0][0] = cs;
+    roty[0][2] = sn;
+    roty[2][0] = -sn;
+    roty[2][2] = cs;
+
+    identity_matrix(rotz);
+    sincos_f16(angles[2], &sn, &cs);
+    rotz[0][0] = cs;
+    rotz[0][1] = -sn;
+    rotz[1][0] = sn;
+    rotz[1][1] = cs;
+
+    FIX_MUL_MAT33_MAT33(temp, rotx, roty);
+    FIX_MUL_MAT33_MAT33(rotation, temp, rotz);
+}
+
+static void fused_matrix(vec3f16 angles)
+{
+    obj.rotated = FALSE;
+    identity_matrix(obj.rotation);
+    rotate_obj(&obj, angles);
+}
+
+static void check_angles(vec3f16 angles, uint32 axes)
+{
+    mat33f16 want;
+    int32 error, limit;
+    uint32 row, col;
+
+    chained_matrix(want, angles);
+    fused_matrix(angles);
+
+    // One axis is a plain copy of its sine and cosine
+    limit = (axes == 1 || axes == 2 || axes == 4) ? 0 : MAX_ERROR;
+
+    for (row = 0; row < 3; row++)
+    {
+        for (col = 0; col < 3; col++)
+        {
+            error = ABS_VALUE(obj.rotation[row][col] - want[row][col]);
+
+            if (error > worst)
+                worst = error;
+
+            if (error > limit)
+            {
+                if (failures < 20)
+                {
+                    printf("FAIL angles %d %d %d: [%u][%u] is %d, chained %d\n", (int) angles[0], (int) angles[1],
+                        (int) angles[2], (unsigned int) row, (unsigned int) col, (int) obj.rotation[row][col],
+                        (int) want[row][col]);
+                }
+
+                failures++;
+                return;
+            }
+        }
+    }
+}
+
+static void check(void)
+{
+    vec3f16 angles;
+    uint32 axes, i, k;
+
+    // Every combination of axes, x and z alone included
+    for (axes = 1; axes < 8; axes++)
+    {
+        for (i = 0; i < CHECK_ANGLES; i++)
+        {
+            for (k = 0; k < 3; k++)
+                angles[k] = (axes & (1 << k)) ? 1 + next_random((256 << FRACBITS_16) - 1) : 0;
+
+            check_angles(angles, axes);
+        }
+    }
+}
+
+static void bench(Boolean fused, const char *name)
+{
+    volatile int32 sink = 0;
+    clock_t start, limit;
+    double seconds;
+    uint32 calls = 0;
+    uint32 i;
+    mat33f16 rotation;
+    vec3f16 angles;
+
+    angles[0] = 0x123456;
+    angles[1] = 0x345678;
+    angles[2] = 0x56789A;
+
+    limit = (clock_t) (BENCH_SECONDS * CLOCKS_PER_SEC);
+    start = clock();
+
+    do
+    {
+        for (i = 0; i < BENCH_CALLS; i++)
+        {
+            if (fused)
+            {
+                fused_matrix(angles);
+                sink += obj.rotation[1][1];
+            }
+            else
+            {
+                chained_matrix(rotation, angles);
+                sink += rotation[1][1];
+            }
+
+            angles[i % 3] += 0x1011;
+        }
+
+        calls += BENCH_CALLS;
+    } while (clock() - start < limit);
+
+    seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    printf("%-7s %.1f ns per matrix\n", name, seconds * 1e9 / calls);
+}
+
+int main(void)
+{
+    check();
+
+    bench(TRUE, "fused");
+    bench(FALSE, "chained");
+
+    printf("euler: largest difference %d, %s\n", (int) worst, failures ? "FAILED" : "ok");
+
+    return(failures != 0);
+}
@@ -0,0 +1,248 @@
+/**
+ * @file fixmath_check.c
+ * @brief Checks the FIXMATH_PORTABLE reference kernels in fixmath.c.
+ *
+ * Exactly representable cases are always checked. Given the path of a log
+ * printed by folioref_dump on a console, every multiply, divide and square root
+ * line is also compared bit for bit against the folio result.
+ *
+ * The scalar and batch kernels are then timed. Batch kernels are reported per
+ * vector so they can be compared against one scalar call each.
+ *
+ * Usage: fixmath_check [folio log]
+ */
+
+#include "fixmath.h"
+#include "folioref.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define F16(x) ((frac16) ((x) * 65536.0))
+
+#define BENCH_CALLS 20000000
+#define BENCH_BATCH 64      // Vectors per batch kernel call, about one object's vertices
+
+#define KERNEL_MUL 0
+#define KERNEL_DIV 1
+#define KERNEL_SQRT 2
+#define KERNEL_DOT3 3
+#define KERNEL_VEC3_MAT33 4
+#define KERNEL_MANY_VEC3_MAT33 5
+#define KERNEL_PROJECT 6
+
+static int failures = 0;
+
+static void expect(const char *what, frac16 got, frac16 want)
+{
+    if (got != want)
+    {
+        printf("FAIL %s: got %08x want %08x\n", what, (unsigned int) got, (unsigned int) want);
+        failures++;
+    }
+}
+
+static void check_exact(void)
+{
+    vec3f16 a = { F16(1.0), F16(2.0), F16(3.0) };
+    vec3f16 b = { F16(4.0), F16(-5.0), F16(0.5) };
+    vec3f16 c;
+    mat33f16 m = { { F16(0.0), F16(1.0), F16(0.0) }, { F16(-1.0), F16(0.0), F16(0.0) }, { F16(0.0), F16(0.0), F16(2.0) } };
+
+    expect("mul 3 * 2.5", fix_mul_f16(F16(3.0), F16(2.5)), F16(7.5));
+    expect("mul -3 * 2.5", fix_mul_f16(F16(-3.0), F16(2.5)), F16(-7.5));
+    expect("mul 0.5 * 0.5", fix_mul_f16(F16(0.5), F16(0.5)), F16(0.25));
+    expect("div 1 / 4", fix_div_f16(F16(1.0), F16(4.0)), F16(0.25));
+    expect("div -9 / 2", fix_div_f16(F16(-9.0), F16(2.0)), F16(-4.5));
+    expect("div 1 / 0", fix_div_f16(F16(1.0), 0), 0x7FFFFFFF);
+    expect("div -1 / 0", fix_div_f16(F16(-1.0), 0), (frac16) 0x80000000);
+    expect("sqrt 4", fix_sqrt_f16(F16(4.0)), F16(2.0));
+    expect("sqrt 0.25", fix_sqrt_f16(F16(0.25)), F16(0.5));
+    expect("sqrt -1", fix_sqrt_f16(F16(-1.0)), 0);
+    expect("dot3", fix_dot3_f16(a, b), F16(-4.5));
+
+    fix_cross3_f16(c, a, b);
+    expect("cross3 x", c[0], F16(16.0));
+    expect("cross3 y", c[1], F16(11.5));
+    expect("cross3 z", c[2], F16(-13.0));
+
+    fix_mul_vec3_mat33_f16(c, a, m);
+    expect("vec3 mat33 x", c[0], F16(-2.0));
+    expect("vec3 mat33 y", c[1], F16(1.0));
+    expect("vec3 mat33 z", c[2], F16(6.0));
+}
+
+static int check_log(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[128];
+    unsigned int kind, index, a, b, result;
+    frac16 got;
+    int compared = 0;
+
+    if (f == NULL)
+    {
+        printf("Error - Could not open %s\n", path);
+        return(-1);
+    }
+
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        if (sscanf(line, "FREF %u %u %x %x %x", &kind, &index, &a, &b, &result) != 5)
+            continue;
+
+        if (kind == FOLIOREF_MUL)
+            got = fix_mul_f16((frac16) a, (frac16) b);
+        else if (kind == FOLIOREF_DIV && b != 0)
+            got = fix_div_f16((frac16) a, (frac16) b);
+        else if (kind == FOLIOREF_SQRT)
+            got = fix_sqrt_f16((frac16) a);
+        else
+            continue;
+
+        if (got != (frac16) result)
+        {
+            printf("FAIL folio kind %u index %u: %08x %08x gave %08x, folio %08x\n", 
+                kind, index, a, b, (unsigned int) got, result);
+            failures++;
+        }
+
+        compared++;
+    }
+
+    fclose(f);
+
+    return(compared);
+}
+
+static void report(const char *name, const char *unit, int32 count, clock_t start)
+{
+    double seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    if (seconds <= 0)
+        seconds = 1e-9;
+
+    printf("%-16s %.1f million %s per second\n", name, count / seconds / 1e6, unit);
+}
+
+static void bench_scalar(uint32 kind, const char *name)
+{
+    volatile frac16 sink = 0;
+    vec3f16 v = { F16(1.5), F16(-2.25), F16(3.0) };
+    vec3f16 out;
+    mat33f16 m = { { F16(0.8), F16(0.6), 0 }, { F16(-0.6), F16(0.8), 0 }, { 0, 0, F16(1.0) } };
+    frac16 a = 0x12345;
+    frac16 b = 0x54321;
+    clock_t start;
+    int32 i;
+
+    start = clock();
+
+    for (i = 0; i < BENCH_CALLS; i++)
+    {
+        switch(kind)
+        {
+        case KERNEL_MUL:
+            sink += fix_mul_f16(a, b);
+            break;
+
+        case KERNEL_DIV:
+            sink += fix_div_f16(a, b);
+            break;
+
+        case KERNEL_SQRT:
+            sink += fix_sqrt_f16(a);
+            break;
+
+        case KERNEL_DOT3:
+            v[0] = a;
+            sink += fix_dot3_f16(v, v);
+            break;
+
+        case KERNEL_VEC3_MAT33:
+            v[0] = a;
+            fix_mul_vec3_mat33_f16(out, v, m);
+            sink += out[0];
+            break;
+        }
+
+        a = (a + 0x3F1D) & 0xFFFFFF;
+        b = ((b + 0x1B07) & 0xFFFFF) + 0x100;
+    }
+
+    report(name, "calls", BENCH_CALLS, start);
+}
+
+static void bench_batch(uint32 kind, const char *name)
+{
+    static vec3f16 src[BENCH_BATCH];
+    static vec3f16 dest[BENCH_BATCH];
+    static Point screen[BENCH_BATCH];
+    volatile frac16 sink = 0;
+    mat33f16 m = { { F16(0.8), F16(0.6), 0 }, { F16(-0.6), F16(0.8), 0 }, { 0, 0, F16(1.0) } };
+    clock_t start;
+    int32 i;
+
+    for (i = 0; i < BENCH_BATCH; i++)
+    {
+        src[i][0] = (i * 0x2F31) & 0x3FFFF;
+        src[i][1] = (i * 0x1D07) & 0x3FFFF;
+        src[i][2] = F16(1.0) + ((i * 0x4A93) & 0xFFFFF);
+    }
+
+    start = clock();
+
+    for (i = 0; i < BENCH_CALLS / BENCH_BATCH; i++)
+    {
+        if (kind == KERNEL_MANY_VEC3_MAT33)
+        {
+            fix_mul_many_vec3_mat33_f16(dest, src, m, BENCH_BATCH);
+            sink += dest[i & (BENCH_BATCH - 1)][0];
+        }
+        else 
+        {
+            fix_project_points_f16(screen, src, BENCH_BATCH, 8, F16(0.25), F16(160), F16(120));
+            sink += screen[i & (BENCH_BATCH - 1)].pt_X;
+        }
+
+        src[i & (BENCH_BATCH - 1)][0] += 0x101;
+    }
+
+    report(name, "vectors", (BENCH_CALLS / BENCH_BATCH) * BENCH_BATCH, start);
+}
+
+int main(int argc, char **argv)
+{
+    int compared;
+
+    check_exact();
+
+    if (argc > 1)
+    {
+        compared = check_log(argv[1]);
+
+        if (compared <= 0)
+        {
+            printf("Error - No folio results in %s\n", argv[1]);
+            return(1);
+        }
+
+        printf("fixmath: %d folio results compared\n", compared);
+    }
+    else
+    {
+        printf("fixmath: no folio log given, exact cases only\n");
+    }
+
+    bench_scalar(KERNEL_MUL, "mul");
+    bench_scalar(KERNEL_DIV, "div");
+    bench_scalar(KERNEL_SQRT, "sqrt");
+    bench_scalar(KERNEL_DOT3, "dot3");
+    bench_scalar(KERNEL_VEC3_MAT33, "vec3 mat33");
+    bench_batch(KERNEL_MANY_VEC3_MAT33, "many vec3 mat33");
+    bench_batch(KERNEL_PROJECT, "project points");
+
+    printf("fixmath: %s\n", failures ? "FAILED" : "ok");
+
+    return(failures != 0);
+}
@@ -0,0 +1,291 @@
+/**
+ * @file host3do.c
+ * @brief Host versions of the SDK calls declared in sdk/host3do.h.
+ *
+ * Memory comes from malloc. FastMapCelf16 maps corners the way the folio does,
+ * for softcel. Files and cels are read from HOST_CD_ROOT, cel files are parsed
+ * from their CCB, PLUT and PDAT chunks. Calls that draw do nothing.
+ */
+
+#include "host3do.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_ID(a, b, c, d) (((uint32) (a) << 24) | ((uint32) (b) << 16) | ((uint32) (c) << 8) | (uint32) (d))
+#define CHUNK_CCB CHUNK_ID('C', 'C', 'B', ' ')
+#define CHUNK_PLUT CHUNK_ID('P', 'L', 'U', 'T')
+#define CHUNK_PDAT CHUNK_ID('P', 'D', 'A', 'T')
+#define CCB_CHUNK_BYTES 80      // Chunk header, version, then ccb_Flags through ccb_Height
+
+uint32 host_msec = 0;
+
+// Disc data is big endian
+static uint32 read_be32(ubyte *p)
+{
+    return(((uint32) p[0] << 24) | ((uint32) p[1] << 16) | ((uint32) p[2] << 8) | (uint32) p[3]);
+}
+
+static FILE *open_disc_file(char *path)
+{
+    char full_path[256];
+
+    if (strlen(HOST_CD_ROOT) + strlen(path) >= sizeof(full_path))
+        return(NULL);
+
+    strcpy(full_path, HOST_CD_ROOT);
+    strcat(full_path, path);
+
+    return(fopen(full_path, "rb"));
+}
+
+void *AllocMem(int32 size, uint32 type)
+{
+    void *p = malloc((size_t) size);
+
+    if (p != NULL && (type & MEMTYPE_FILL))
+        memset(p, 0, (size_t) size);
+
+    return(p);
+}
+
+void FreeMem(void *p, int32 size)
+{
+    (void) size;
+    free(p);
+}
+
+void AvailMem(MemInfo *info, uint32 type)
+{
+    (void) type;
+    info->minfo_SysFree = 0;
+    info->minfo_SysLargest = 0;
+}
+
+/*  Allocates the source and PLUT when source is NULL, like the SDK. Rows get room for the
+    prefetch words as well. DeleteCel leaves them, host checks are short lived. */
+CCB *CreateCel(int32 width, int32 height, int32 bpp, int32 options, void *source)
+{
+    CCB *ccb = (CCB *) AllocMem(sizeof(CCB), MEMTYPE_FILL);
+    int32 row_bytes = (((width * bpp + 31) >> 5) + PRE1_WOFFSET_PREFETCH) << 2;
+
+    if (ccb == NULL)
+        return(NULL);
+
+    if (source == NULL)
+    {
+        source = AllocMem(row_bytes * height, MEMTYPE_FILL);
+
+        if (options == CREATECEL_CODED)
+            ccb->ccb_PLUTPtr = AllocMem(sizeof(uint16) * 32, MEMTYPE_FILL);
+    }
+
+    ccb->ccb_Width = width;
+    ccb->ccb_Height = height;
+    ccb->ccb_SourcePtr = (CelData *) source;
+    ccb->ccb_HDX = 1 << 20;
+    ccb->ccb_VDY = 1 << 16;
+    ccb->ccb_PIXC = 0x1F001F00;     // Opaque
+
+    return(ccb);
+}
+
+void DeleteCel(CCB *ccb)
+{
+    FreeMem(ccb, sizeof(CCB));
+}
+
+void FastMapCelInit(CCB *ccb)
+{
+    (void) ccb;
+}
+
+// Same mapping as the folio: corners 0, 1, 2, 3 are the cel's top left, top right, bottom right and bottom left
+void FastMapCelf16(CCB *ccb, Point *corners)
+{
+    int32 width = ccb->ccb_Width;
+    int32 height = ccb->ccb_Height;
+
+    ccb->ccb_XPos = corners[0].pt_X;
+    ccb->ccb_YPos = corners[0].pt_Y;
+    ccb->ccb_HDX = (int32) (((int64_t) (corners[1].pt_X - corners[0].pt_X) << 4) / width);
+    ccb->ccb_HDY = (int32) (((int64_t) (corners[1].pt_Y - corners[0].pt_Y) << 4) / width);
+    ccb->ccb_VDX = (corners[3].pt_X - corners[0].pt_X) / height;
+    ccb->ccb_VDY = (corners[3].pt_Y - corners[0].pt_Y) / height;
+    ccb->ccb_HDDX = (int32) (((int64_t) (corners[2].pt_X - corners[3].pt_X - corners[1].pt_X + corners[0].pt_X) << 4) / 
+        ((int64_t) width * height));
+    ccb->ccb_HDDY = (int32) (((int64_t) (corners[2].pt_Y - corners[3].pt_Y - corners[1].pt_Y + corners[0].pt_Y) << 4) / 
+        ((int64_t) width * height));
+}
+
+int32 DrawCels(Item bitmap_item, CCB *ccb)
+{
+    (void) bitmap_item;
+    (void) ccb;
+    return(0);
+}
+
+void SetFGPen(GrafCon *gcon, uint32 color)
+{
+    (void) gcon;
+    (void) color;
+}
+
+int32 DrawTo(Item bitmap_item, GrafCon *gcon, Coord x, Coord y)
+{
+    (void) bitmap_item;
+    gcon->gc_PenX = x;
+    gcon->gc_PenY = y;
+    return(0);
+}
+
+void *LoadFile(char *path, long *size, uint32 type)
+{
+    FILE *f = open_disc_file(path);
+    void *data;
+
+    *size = 0;
+
+    if (f == NULL)
+        return(NULL);
+
+    fseek(f, 0, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    data = AllocMem((int32) *size, type);
+
+    if (data != NULL && fread(data, 1, (size_t) *size, f) != (size_t) *size)
+    {
+        FreeMem(data, (int32) *size);
+        data = NULL;
+    }
+
+    fclose(f);
+
+    return(data);
+}
+
+void UnloadFile(void *data)
+{
+    FreeMem(data, 0);
+}
+
+/*  Each CCB chunk starts a cel, the PLUT and PDAT chunks after it belong to that cel. 
+    Cels in one file are linked in order and the last one is marked. */
+CCB *LoadCel(char *path, uint32 type)
+{
+    long size;
+    ubyte *data = (ubyte *) LoadFile(path, &size, MEMTYPE_DRAM);
+    ubyte *p;
+    uint32 id, chunk_bytes, i, count;
+    ubyte *field;
+    uint16 *plut;
+    CCB *first = NULL;
+    CCB *ccb = NULL;
+    CCB *next;
+
+    if (data == NULL)
+        return(NULL);
+
+    for (p = data; p + 8 <= data + size; p += chunk_bytes)
+    {
+        id = read_be32(p);
+        chunk_bytes = read_be32(p + 4);
+
+        if (chunk_bytes < 8 || p + chunk_bytes > data + size)
+            break;
+
+        if (id == CHUNK_CCB && chunk_bytes >= CCB_CHUNK_BYTES)
+        {
+            // Pointers are wider on the host, so fields are copied one by one. The chunk's pointers are not used.
+            next = (CCB *) AllocMem(sizeof(CCB), type | MEMTYPE_FILL);
+            field = p + 12;
+
+            next->ccb_Flags = read_be32(field) & ~CCB_LAST;
+            next->ccb_XPos = (Coord) read_be32(field + 16);
+            next->ccb_YPos = (Coord) read_be32(field + 20);
+            next->ccb_HDX = (int32) read_be32(field + 24);
+            next->ccb_HDY = (int32) read_be32(field + 28);
+            next->ccb_VDX = (int32) read_be32(field + 32);
+            next->ccb_VDY = (int32) read_be32(field + 36);
+            next->ccb_HDDX = (int32) read_be32(field + 40);
+            next->ccb_HDDY = (int32) read_be32(field + 44);
+            next->ccb_PIXC = read_be32(field + 48);
+            next->ccb_PRE0 = read_be32(field + 52);
+            next->ccb_PRE1 = read_be32(field + 56);
+            next->ccb_Width = (int32) read_be32(field + 60);
+            next->ccb_Height = (int32) read_be32(field + 64);
+
+            if (ccb)
+                ccb->ccb_NextPtr = next;
+            else 
+                first = next;
+
+            ccb = next;
+        }
+        else if (id == CHUNK_PLUT && ccb && chunk_bytes >= 12)
+        {
+            count = read_be32(p + 8);
+
+            if (12 + count * 2 > chunk_bytes)
+                break;
+
+            plut = (uint16 *) AllocMem(sizeof(uint16) * count, type);
+
+            for (i = 0; i < count; i++)
+                plut[i] = (uint16) ((p[12 + i * 2] << 8) | p[13 + i * 2]);
+
+            ccb->ccb_PLUTPtr = plut;
+        }
+        else if (id == CHUNK_PDAT && ccb)
+        {
+            ccb->ccb_SourcePtr = (CelData *) AllocMem(chunk_bytes - 8, type);
+            memcpy(ccb->ccb_SourcePtr, p + 8, chunk_bytes - 8);
+        }
+    }
+
+    UnloadFile(data);
+
+    if (ccb)
+        ccb->ccb_Flags |= CCB_LAST;
+
+    return(first);
+}
+
+// Stops at the cel LoadCel marked last, callers may have linked it onward
+void DeleteCelList(CCB *ccb)
+{
+    CCB *next;
+
+    while (ccb)
+    {
+        next = (ccb->ccb_Flags & CCB_LAST) ? NULL : ccb->ccb_NextPtr;
+        FreeMem(ccb->ccb_SourcePtr, 0);
+        FreeMem(ccb->ccb_PLUTPtr, 0);
+        FreeMem(ccb, sizeof(CCB));
+        ccb = next;
+    }
+}
+
+int32 GetFileSize(char *path)
+{
+    FILE *f = open_disc_file(path);
+    int32 size;
+
+    if (f == NULL)
+        return(-1);
+
+    fseek(f, 0, SEEK_END);
+    size = (int32) ftell(f);
+    fclose(f);
+
+    return(size);
+}
+
+uint32 GetMSecTime(Item timer_io)
+{
+    (void) timer_io;
+    return(host_msec);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file host_game.c
+ * @brief Globals and resource loading normally provided by app.c and resources.c.
+ *
+ * Those files need more of the SDK than tools/host/sdk provides. Files and cels
+ * are loaded from the CD directory through the calls in host3do.c, other
+ * resource types fail. The checks set the display size themselves.
+ */
+
+#include "app_globals.h"
+#include "resources.h"
+
+#include <string.h>
+
+ScreenContext *sc = 0;
+uint32 display_width = 320;
+uint32 display_height = 240;
+uint32 display_width2 = 160;
+uint32 display_height2 = 120;
+uint32 display_width2_f16 = 160 << 16;
+uint32 display_height2_f16 = 120 << 16;
+Item time_io = 0;
+
+int32 load_resource(char *path, uint32 type, rez_envelope_typ_ptr rez_envelope)
+{
+    memset((void*)rez_envelope, 0, sizeof(rez_envelope_typ));
+
+    switch(type)
+    {
+    case REZ_FILE:
+        rez_envelope->data = LoadFile(path, &rez_envelope->file_bytes, MEMTYPE_DRAM);
+        break;
+
+    case REZ_CEL:
+    case REZ_CEL_LIST:
+        rez_envelope->data = (void*) LoadCel(path, MEMTYPE_CEL);
+
+        if (rez_envelope->data)
+        {
+            ((CCB*)rez_envelope->data)->ccb_Flags &= ~CCB_LAST; // Same as resources.c
+            rez_envelope->file_bytes = GetFileSize(path);
+        }
+        break;
+    }
+
+    if (!rez_envelope->data)
+        return(-1);
+
+    rez_envelope->seek_bytes = rez_envelope->file_bytes;
+    rez_envelope->seek = rez_envelope->data;
+
+    return(0);
+}
+
+// Files hold big endian words
+Boolean seek_rez_data(rez_envelope_typ_ptr rez, int32 *data)
+{
+    ubyte *buffer = (ubyte*) rez->seek;
+
+    if (rez->seek_bytes <= 0)
+        return(FALSE);
+
+    *data = (int32) (((uint32) buffer[0] << 24) | ((uint32) buffer[1] << 16) | ((uint32) buffer[2] << 8) | buffer[3]);
+    rez->seek = (void*) (buffer + 4);
+    rez->seek_bytes -= 4;
+
+    return(TRUE);
+}
+
+void unload_resource(rez_envelope_typ_ptr rez_envelope, uint32 type)
+{
+    if (!rez_envelope || !rez_envelope->data)
+        return;
+
+    if (type == REZ_FILE)
+        UnloadFile(rez_envelope->data);
+    else if (type == REZ_CEL)
+        DeleteCel((CCB*)rez_envelope->data);
+    else if (type == REZ_CEL_LIST)
+        DeleteCelList((CCB*)rez_envelope->data);
+}
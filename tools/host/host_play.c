@@ -0,0 +1,62 @@
+/**
+ * @file host_play.c
+ * @brief Globals and calls normally provided by levels.c, player.c and gs_play.c.
+ *
+ * Those files need threads, audio and input. Enemy code built for the host
+ * runs against a level loaded here and a player that is never hit.
+ */
+
+#include "host_play.h"
+
+level_context_typ lc;
+uint32 current_level = 1;
+uint32 level_counter = 1;
+player_typ player;
+
+level_typ_ptr host_load_level(uint32 number)
+{
+    char file_path[28];
+    level_typ_ptr level = &lc.levels[0];
+    uint32 i;
+
+    sprintf(file_path, "Assets/Levels/Level%d", (int) number);
+
+    level->number = number;
+    level->obj = load_obj(file_path);
+
+    if (!level->obj)
+    {
+        printf("Error - Could not load %s, run from the repository root.\n", file_path);
+        return(NULL);
+    }
+
+    // Same wrapping levels as load_level
+    level->wrap = (number == 5 || number == 7 || number == 10 || number == 13 || number == 14 || 
+        number == 18 || number == 20) ? TRUE : FALSE;
+
+    for (i = 0; i < level->obj->poly_count; i++)
+    {
+        level->obj->polygons[i].ccb = create_coded_colored_cel8(16, 16, 0);
+        calc_poly_normal(&level->obj->polygons[i]);
+        memcpy((void*)level->palettes[i], (void*)level->obj->polygons[i].ccb->ccb_PLUTPtr, PALETTE_SIZE_BYTES);
+    }
+
+    init_corridors(level);
+
+    lc.level_index = 0;
+    current_level = number;
+    player.corridor_index = -1;
+
+    return(level);
+}
+
+Boolean check_player_collision(enemy_typ_ptr enemy)
+{
+    (void) enemy;
+    return(FALSE);
+}
+
+void player_hit(enemy_typ_ptr enemy)
+{
+    (void) enemy;
+}
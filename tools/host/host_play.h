@@ -0,0 +1,19 @@
+/**
+ * @file host_play.h
+ * @brief Level loading for host checks that run the game's enemy code.
+ */
+
+#ifndef HOST_PLAY_H
+#define HOST_PLAY_H
+
+#include "game_globals.h"
+
+/**
+ * @brief Load a level into lc.levels[0] the way levels.c does, and make it current.
+ * 
+ * @param number Level file number, 1 - 20
+ * @return level_typ_ptr 
+ */
+level_typ_ptr host_load_level(uint32 number);
+
+#endif // HOST_PLAY_H
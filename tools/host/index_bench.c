@@ -0,0 +1,278 @@
+/**
+ * @file index_bench.c
+ * @brief Checks bullet collision through the corridor index and times it against a full scan.
+ *
+ * Enemies are spawned and updated on a loaded level with MAX_ENEMIES raised, so
+ * flippers roll and fuseballs side step on the near rim while others walk their
+ * corridors. Every frame, after sort_corridor_enemies:
+ *  - each corridor list must be ordered nearest first
+ *  - the rim list must hold exactly the active flippers and fuseballs on the rim
+ *  - get_bullet_enemy must agree with the scan over every enemy slot that
+ *    update_bullets used before the index, for bullets at many depths on every
+ *    corridor. Either both find nothing, or the indexed pick is one the scan
+ *    could also hit. The scan takes the lowest slot, the index the nearest.
+ *
+ * Finally a frame's sort and bullet tests are timed against the scan alone.
+ *
+ * Build with MAX_ENEMIES raised, at least 32.
+ */
+
+#include "host_play.h"
+
+#include <time.h>
+
+#define FRAME_MSEC 16
+#define FRAME_DELTA 256
+#define CHECK_FRAMES 1500
+#define BULLET_DEPTHS 24        // Bullet positions per corridor, from the near rim to the far end
+#define BENCH_SECONDS 0.25
+
+static bullet_typ bullet;
+static object_typ bullet_obj;
+static uint32 rim_hits = 0;
+static uint32 corridor_hits = 0;
+static int failures = 0;
+
+// update_bullets before the index, minus the spike test
+static Boolean scan_can_hit(enemy_typ_ptr enemy_it, bullet_typ_ptr bullet_it)
+{
+    int32 delta_x, delta_y, dist;
+    vec3f16 p1;
+    corridor_typ_ptr corridor;
+
+    if (enemy_it->state != ES_ACTIVE)
+        return(FALSE);
+
+    if ((enemy_it->enemy_type == FLIPPER || enemy_it->enemy_type == FUSEBALL) &&
+        enemy_it->obj->world_z == LEVEL_ZNEAR)
+    {
+        if (bullet_it->obj->world_z <= (LEVEL_ZNEAR + 32768))
+        {
+            delta_x = ABS_VALUE(enemy_it->obj->world_x - bullet_it->obj->world_x);
+            delta_y = ABS_VALUE(enemy_it->obj->world_y - bullet_it->obj->world_y);
+
+            if (delta_x < 12000 && delta_y < 12000)
+                return(TRUE);
+        }
+    }
+
+    if (bullet_it->corridor_index == enemy_it->corridor_index &&
+        bullet_it->obj->world_z >= enemy_it->obj->world_z - 16384 &&
+        bullet_it->obj->world_z <= enemy_it->obj->world_z + 16384)
+    {
+        if (enemy_it->enemy_type != FUSEBALL)
+            return(TRUE);
+
+        corridor = get_corridor(enemy_it->corridor_index);
+
+        p1[X] = enemy_it->obj->world_x;
+        p1[Y] = enemy_it->obj->world_y;
+        p1[Z] = corridor->near_edge[1][Z];
+
+        dist = get_squared_dist(p1, corridor->near_edge[1]);
+
+        if (dist < 1000)
+            return(TRUE);
+    }
+
+    return(FALSE);
+}
+
+static enemy_typ_ptr scan_hit(bullet_typ_ptr bullet_it)
+{
+    uint32 j;
+
+    for (j = 0; j < MAX_ENEMIES; j++)
+    {
+        if (scan_can_hit(&enemies[j], bullet_it))
+            return(&enemies[j]);
+    }
+
+    return(NULL);
+}
+
+static void place_bullet(uint32 corridor_index, int32 z)
+{
+    snap_obj_to_corridor(bullet.obj, corridor_index, z);
+    bullet.corridor_index = corridor_index;
+}
+
+// Depth d of BULLET_DEPTHS, the first few close together on the rim where the tests overlap
+static int32 bullet_depth(uint32 d)
+{
+    if (d < 4)
+        return(LEVEL_ZNEAR + (int32) d * 12288);
+
+    return(LEVEL_ZNEAR + (int32) ((d - 4) * (uint32) (LEVEL_ZFAR - LEVEL_ZNEAR) / (BULLET_DEPTHS - 5)));
+}
+
+static void check_order(uint32 frame, uint32 corridor_count)
+{
+    enemy_typ_ptr enemy, next;
+    enemy_typ_ptr *rim;
+    uint32 i, j, rim_count, want_rim = 0;
+
+    for (i = 0; i < corridor_count; i++)
+    {
+        for (enemy = get_corridor_enemy(i); enemy; enemy = next)
+        {
+            next = get_next_corridor_enemy(enemy);
+
+            if (next && next->obj->world_z < enemy->obj->world_z)
+            {
+                printf("FAIL frame %u: corridor %u is out of order\n", (unsigned int) frame, (unsigned int) i);
+                failures++;
+                break;
+            }
+        }
+    }
+
+    rim_count = get_rim_enemies(&rim);
+
+    for (i = 0; i < MAX_ENEMIES; i++)
+    {
+        if (enemies[i].state != ES_ACTIVE || !IS_RIM_ENEMY(&enemies[i]))
+            continue;
+
+        ++want_rim;
+
+        for (j = 0; j < rim_count && rim[j] != &enemies[i]; j++)
+            ;
+
+        if (j == rim_count)
+        {
+            printf("FAIL frame %u: rim enemy in slot %u is not in the rim list\n", (unsigned int) frame, (unsigned int) i);
+            failures++;
+        }
+    }
+
+    if (rim_count != want_rim)
+    {
+        printf("FAIL frame %u: %u rim enemies listed, want %u\n", (unsigned int) frame,
+            (unsigned int) rim_count, (unsigned int) want_rim);
+        failures++;
+    }
+}
+
+static void check_bullets(uint32 frame, uint32 corridor_count)
+{
+    enemy_typ_ptr indexed, scanned;
+    uint32 i, d;
+
+    for (i = 0; i < corridor_count; i++)
+    {
+        for (d = 0; d < BULLET_DEPTHS; d++)
+        {
+            place_bullet(i, bullet_depth(d));
+
+            indexed = get_bullet_enemy(&bullet);
+            scanned = scan_hit(&bullet);
+
+            if ((indexed == NULL) != (scanned == NULL) || (indexed && !scan_can_hit(indexed, &bullet)))
+            {
+                if (failures < 20)
+                {
+                    printf("FAIL frame %u: bullet on corridor %u at z %d hits slot %d, scan hits slot %d\n",
+                        (unsigned int) frame, (unsigned int) i, (int) bullet.obj->world_z,
+                        indexed ? (int) (indexed - enemies) : -1, scanned ? (int) (scanned - enemies) : -1);
+                }
+
+                failures++;
+            }
+            else if (indexed)
+            {
+                if (IS_RIM_ENEMY(indexed))
+                    ++rim_hits;
+                else
+                    ++corridor_hits;
+            }
+        }
+    }
+}
+
+static double time_frames(uint32 corridor_count, Boolean indexed)
+{
+    volatile uint32 sink = 0;
+    clock_t start, limit;
+    uint32 frames = 0;
+    uint32 i;
+
+    limit = (clock_t) (BENCH_SECONDS * CLOCKS_PER_SEC);
+    start = clock();
+
+    // One bullet per slot, spread over the corridors and depths
+    do
+    {
+        if (indexed)
+            sort_corridor_enemies();
+
+        for (i = 0; i < MAX_BULLETS; i++)
+        {
+            place_bullet((frames + i * 7) % corridor_count, bullet_depth((frames + i * 5) % BULLET_DEPTHS));
+            sink += (uint32) (size_t) (indexed ? get_bullet_enemy(&bullet) : scan_hit(&bullet));
+        }
+
+        frames++;
+    } while (clock() - start < limit);
+
+    return((double) (clock() - start) / CLOCKS_PER_SEC * 1e6 / frames);
+}
+
+int main(void)
+{
+    level_typ_ptr level;
+    uint32 count, frame, live, i;
+    double indexed, scanned;
+
+    srand(2);
+    init_enemies();
+
+    level = host_load_level(5);
+
+    if (!level)
+        return(1);
+
+    count = level->obj->poly_count;
+    current_level = 99;
+
+    bullet.obj = &bullet_obj;
+    bullet.active = TRUE;
+    identity_matrix(bullet_obj.rotation);
+
+    clear_hostiles();
+
+    for (frame = 0; frame < CHECK_FRAMES; frame++)
+    {
+        spawn_next_enemy();
+
+        host_msec += FRAME_MSEC;
+        update_enemies(FRAME_DELTA);
+
+        sort_corridor_enemies();
+        check_order(frame, count);
+        check_bullets(frame, count);
+    }
+
+    if (rim_hits == 0 || corridor_hits == 0)
+    {
+        printf("FAIL %u rim hits and %u corridor hits, both paths should be taken\n",
+            (unsigned int) rim_hits, (unsigned int) corridor_hits);
+        failures++;
+    }
+
+    for (i = 0, live = 0; i < MAX_ENEMIES; i++)
+    {
+        if (enemies[i].state == ES_ACTIVE)
+            ++live;
+    }
+
+    indexed = time_frames(count, TRUE);
+    scanned = time_frames(count, FALSE);
+
+    printf("index: %u rim hits, %u corridor hits checked\n", (unsigned int) rim_hits, (unsigned int) corridor_hits);
+    printf("index: %u of %u enemies, %u bullets, index %.2f us, scan %.2f us per frame\n", (unsigned int) live,
+        (unsigned int) MAX_ENEMIES, (unsigned int) MAX_BULLETS, indexed, scanned);
+    printf("index: %s\n", failures ? "FAILED" : "ok");
+
+    return(failures != 0);
+}
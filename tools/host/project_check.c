@@ -0,0 +1,151 @@
+/**
+ * @file project_check.c
+ * @brief Checks points_to_screen against the per point path it replaced and times both.
+ *
+ * Stars, spikes and explosions used to be projected one at a time with
+ * point_to_camera and point_to_screen using the inverse depth table. For points
+ * in front of the near plane the batched call must give exactly the same
+ * screen points. Spikes clamped camera z to the near plane before projecting,
+ * so that path must match for points behind it too. The unclamped path mirrored
+ * points behind the camera and is not compared there.
+ */
+
+#include "threed.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define POINT_COUNT 64
+#define NEAR 32768              // CAM_NEAR in game_globals.h
+#define BENCH_SECONDS 0.25
+
+static vec3f16 points[POINT_COUNT];
+static Point batched[POINT_COUNT];
+static Point single[POINT_COUNT];
+static uint32 seed = 12345;
+static int failures = 0;
+
+static int32 next_random(int32 range)
+{
+    seed = seed * 1664525 + 1013904223;
+    return((int32) ((seed >> 8) % (uint32) range));
+}
+
+// World points with camera z in [z_min, z_max), x and y about as wide as the view
+static void make_points(int32 z_min, int32 z_max)
+{
+    int32 i, z;
+
+    for (i = 0; i < POINT_COUNT; i++)
+    {
+        z = z_min + next_random(z_max - z_min);
+        points[i][0] = camera.world_x + next_random(8 << FRACBITS_16) - (4 << FRACBITS_16);
+        points[i][1] = camera.world_y + next_random(6 << FRACBITS_16) - (3 << FRACBITS_16);
+        points[i][2] = camera.world_z + z;
+    }
+}
+
+// How each point was projected before points_to_screen, clamp as draw_spikes did
+static void project_single(Boolean clamp)
+{
+    vec3f16 cam;
+    int32 i;
+
+    for (i = 0; i < POINT_COUNT; i++)
+    {
+        point_to_camera(cam, points[i]);
+
+        if (clamp && cam[2] < NEAR)
+            cam[2] = NEAR;
+
+        point_to_screen(&single[i], cam, TRUE);
+    }
+}
+
+static void compare(const char *name)
+{
+    int32 i;
+
+    for (i = 0; i < POINT_COUNT; i++)
+    {
+        if (batched[i].pt_X != single[i].pt_X || batched[i].pt_Y != single[i].pt_Y)
+        {
+            if (failures < 20)
+            {
+                printf("FAIL %s: point %d at camera z %d gave %d, %d, per point path %d, %d\n", name, (int) i,
+                    (int) (points[i][2] - camera.world_z), (int) batched[i].pt_X, (int) batched[i].pt_Y,
+                    (int) single[i].pt_X, (int) single[i].pt_Y);
+            }
+
+            failures++;
+            return;
+        }
+    }
+}
+
+static void check(void)
+{
+    int32 pass;
+
+    for (pass = 0; pass < 64; pass++)
+    {
+        // In front of the near plane, across the whole depth table
+        make_points(NEAR + 1, 16 << FRACBITS_16);
+        points_to_screen(batched, points, POINT_COUNT, NEAR);
+        project_single(FALSE);
+        compare("in front");
+
+        project_single(TRUE);
+        compare("in front, clamped");
+
+        // Straddling the near plane and the camera
+        make_points(-(2 << FRACBITS_16), 2 << FRACBITS_16);
+        points_to_screen(batched, points, POINT_COUNT, NEAR);
+        project_single(TRUE);
+        compare("behind, clamped");
+    }
+}
+
+static void bench(Boolean use_batch, const char *name)
+{
+    clock_t start, limit;
+    double seconds;
+    uint32 calls = 0;
+
+    limit = (clock_t) (BENCH_SECONDS * CLOCKS_PER_SEC);
+    start = clock();
+
+    do
+    {
+        if (use_batch)
+            points_to_screen(batched, points, POINT_COUNT, NEAR);
+        else
+            project_single(TRUE);
+
+        points[calls & (POINT_COUNT - 1)][0] += 0x101;
+        calls++;
+    } while (clock() - start < limit);
+
+    seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    printf("%-9s %.1f million points per second\n", name, (double) calls * POINT_COUNT / seconds / 1e6);
+}
+
+int main(void)
+{
+    camera.world_x = 3 << (FRACBITS_16 - 2);
+    camera.world_y = -(1 << (FRACBITS_16 - 1));
+    camera.world_z = -(5 << FRACBITS_16);
+
+    init_3d();
+
+    check();
+
+    make_points(NEAR + 1, 16 << FRACBITS_16);
+    bench(TRUE, "batched");
+    bench(FALSE, "per point");
+
+    printf("project: %s\n", failures ? "FAILED" : "ok");
+
+    return(failures != 0);
+}
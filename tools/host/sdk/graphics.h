@@ -0,0 +1,2 @@
+// Host stand in, see host3do.h
+#include "host3do.h"
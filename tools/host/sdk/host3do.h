@@ -0,0 +1,175 @@
+/**
+ * @file host3do.h
+ * @brief The subset of the 3DO SDK the engine code needs, for host builds.
+ *
+ * tools/host/sdk stands in for the SDK include directory when build_host.sh
+ * compiles engine sources with the system compiler. Each SDK header name there
+ * includes this file. Structures match the SDK layouts for the fields the
+ * engine touches. Functions are implemented in tools/host/host3do.c, where
+ * anything that needs the console does nothing. Files are read from the CD
+ * directory of the repository, so checks run from its root.
+ */
+
+#ifndef HOST3DO_H
+#define HOST3DO_H
+
+#include "portable.h"
+
+typedef uint32 CelData;
+
+typedef struct Rect
+{
+    Coord rect_XLeft;
+    Coord rect_YTop;
+    Coord rect_XRight;
+    Coord rect_YBottom;
+} Rect;
+
+typedef struct CCB
+{
+    uint32 ccb_Flags;
+    struct CCB *ccb_NextPtr;
+    CelData *ccb_SourcePtr;
+    void *ccb_PLUTPtr;
+    Coord ccb_XPos;
+    Coord ccb_YPos;
+    int32 ccb_HDX;
+    int32 ccb_HDY;
+    int32 ccb_VDX;
+    int32 ccb_VDY;
+    int32 ccb_HDDX;
+    int32 ccb_HDDY;
+    uint32 ccb_PIXC;
+    uint32 ccb_PRE0;
+    uint32 ccb_PRE1;
+    int32 ccb_Width;
+    int32 ccb_Height;
+} CCB;
+
+typedef struct GrafCon
+{
+    Coord gc_PenX;
+    Coord gc_PenY;
+} GrafCon;
+
+typedef struct Bitmap
+{
+    void *bm_Buffer;
+} Bitmap;
+
+typedef struct ScreenContext
+{
+    int32 sc_NumScreens;
+    int32 sc_CurrentScreen;
+    Item sc_ScreenItems[2];
+    Item sc_BitmapItems[2];
+    Bitmap *sc_Bitmaps[2];
+    int32 sc_NumBitmapPages;
+} ScreenContext;
+
+typedef struct MemInfo
+{
+    uint32 minfo_SysFree;
+    uint32 minfo_SysLargest;
+} MemInfo;
+
+typedef struct ControlPadEventData
+{
+    uint32 cped_ButtonBits;
+} ControlPadEventData;
+
+typedef struct MouseEventData
+{
+    uint32 med_ButtonBits;
+    int32 med_HorizPosition;
+    int32 med_VertPosition;
+} MouseEventData;
+
+// CCB flags
+#define CCB_SKIP 0x80000000
+#define CCB_LAST 0x40000000
+#define CCB_NPABS 0x20000000
+#define CCB_SPABS 0x10000000
+#define CCB_PPABS 0x08000000
+#define CCB_LDSIZE 0x04000000
+#define CCB_LDPRS 0x02000000
+#define CCB_LDPPMP 0x01000000
+#define CCB_LDPLUT 0x00800000
+#define CCB_CCBPRE 0x00400000
+#define CCB_YOXY 0x00200000
+#define CCB_ACSC 0x00100000
+#define CCB_ALSC 0x00080000
+#define CCB_ACW 0x00040000
+#define CCB_ACCW 0x00020000
+#define CCB_TWD 0x00010000
+#define CCB_LCE 0x00008000
+#define CCB_ACE 0x00004000
+#define CCB_MARIA 0x00001000
+#define CCB_PXOR 0x00000800
+#define CCB_USEAV 0x00000400
+#define CCB_PACKED 0x00000200
+#define CCB_PLUTPOS 0x00000080
+#define CCB_BGND 0x00000020
+#define CCB_NOBLK 0x00000010
+
+// Preamble fields
+#define PRE0_LINEAR 0x10
+#define PRE0_REP8 0x08
+#define PRE0_BPP_MASK 0x7
+#define PRE0_BPP_SHIFT 0
+#define PRE0_BPP_8 5
+#define PRE0_BPP_16 6
+#define PRE0_VCNT_MASK 0xFFC0
+#define PRE0_VCNT_SHIFT 6
+#define PRE0_VCNT_PREFETCH 1
+#define PRE0_SKIPX_MASK 0x0F000000
+#define PRE0_SKIPX_SHIFT 24
+#define PRE1_WOFFSET8_MASK 0xFF000000
+#define PRE1_WOFFSET8_SHIFT 24
+#define PRE1_WOFFSET10_MASK 0x03FF0000
+#define PRE1_WOFFSET10_SHIFT 16
+#define PRE1_WOFFSET_PREFETCH 2
+#define PRE1_LRFORM 0x800
+#define PRE1_TLHPCNT_MASK 0x7FF
+#define PRE1_TLHPCNT_SHIFT 0
+#define PRE1_TLHPCNT_PREFETCH 1
+
+#define CEL_PRE1WORD(c) ((c)->ccb_PRE1)
+#define LAST_CEL(c) ((c)->ccb_Flags |= CCB_LAST)
+#define UNLAST_CEL(c) ((c)->ccb_Flags &= ~CCB_LAST)
+#define SKIP_CEL(c) ((c)->ccb_Flags |= CCB_SKIP)
+#define UNSKIP_CEL(c) ((c)->ccb_Flags &= ~CCB_SKIP)
+#define CREATECEL_UNCODED 0
+#define CREATECEL_CODED 1
+#define MakeRGB15(r, g, b) (((r) << 10) | ((g) << 5) | (b))
+
+#define MEMTYPE_ANY 0
+#define MEMTYPE_DRAM 1
+#define MEMTYPE_VRAM 2
+#define MEMTYPE_CEL 4
+#define MEMTYPE_FILL 8
+
+#define HOST_CD_ROOT "CD/"
+
+// GetMSecTime returns this, checks advance it themselves
+extern uint32 host_msec;
+
+void *AllocMem(int32 size, uint32 type);
+void FreeMem(void *p, int32 size);
+void AvailMem(MemInfo *info, uint32 type);
+
+CCB *CreateCel(int32 width, int32 height, int32 bpp, int32 options, void *source);
+void DeleteCel(CCB *ccb);
+void FastMapCelInit(CCB *ccb);
+void FastMapCelf16(CCB *ccb, Point *corners);
+int32 DrawCels(Item bitmap_item, CCB *ccb);
+void SetFGPen(GrafCon *gcon, uint32 color);
+int32 DrawTo(Item bitmap_item, GrafCon *gcon, Coord x, Coord y);
+void *LoadFile(char *path, long *size, uint32 type);
+void UnloadFile(void *data);
+CCB *LoadCel(char *path, uint32 type);
+void DeleteCelList(CCB *ccb);
+int32 GetFileSize(char *path);
+uint32 GetMSecTime(Item timer_io);
+
+#endif // HOST3DO_H
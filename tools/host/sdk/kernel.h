@@ -0,0 +1,4 @@
+// Host stand in, see host3do.h
+#include "host3do.h"
+
+#include <stdlib.h>     // rand, which the SDK declares through its kernel headers
@@ -0,0 +1,7 @@
+// Host stand in, see host3do.h
+#include "host3do.h"
+#include "fixmath.h"
+
+// Folio calls the game makes directly, mapped to the portable kernels
+#define MulSF16(a, b) fix_mul_f16(a, b)
+#define Dot3_F16(a, b) fix_dot3_f16(a, b)
@@ -0,0 +1,474 @@
+/**
+ * @file softcel_bench.c
+ * @brief Checks softcel coverage and times capture replay.
+ *
+ * A cel drawn 1:1 at a whole pixel position must write exactly its own texels.
+ * A frame built through the display list is then captured with capture_frame,
+ * replayed with capture_replay and compared against drawing the list directly.
+ * Damaged copies of the capture must be refused by capture_load. Finally the
+ * replay is timed and reported in frames and pixels per second.
+ *
+ * The cel cost estimator is checked on its own, first on cels whose cost is
+ * known, then over the built frame against what softcel drew and against the
+ * report capture_replay adds up. Its report for the frame is printed and the
+ * estimator is timed alone.
+ *
+ * Usage: softcel_bench [capture file]
+ *
+ * Given a file made by tools/capture_extract.py, that capture is timed instead
+ * of the built frame.
+ */
+
+#include "capture.h"
+#include "dlist.h"
+#include "cel_helper.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define TARGET_WIDTH 320
+#define TARGET_HEIGHT 240
+#define SPRITE_COUNT 24
+#define POLY_COUNT 96
+#define BENCH_SECONDS 1.0
+#define F16(x) ((x) << 16)
+
+static uint16 pixels[TARGET_WIDTH * TARGET_HEIGHT];
+static uint16 expected[TARGET_WIDTH * TARGET_HEIGHT];
+static uint32 replay_data[CAPTURE_BUFFER_SIZE >> 2];
+static celcost_report_typ report;
+static celcost_report_typ replay_report;
+static uint32 seed = 12345;
+static int failures = 0;
+
+static int32 next_random(int32 range)
+{
+    seed = seed * 1664525 + 1013904223;
+    return((int32) ((seed >> 8) % (uint32) range));
+}
+
+// Checker texture with a transparent border, palette entry 0 is transparent
+static CCB *make_cel(int32 width, int32 height, uint16 color)
+{
+    CCB *ccb = create_coded_cel8(width, height, TRUE);
+    ubyte *src = (ubyte*) ccb->ccb_SourcePtr;
+    uint16 *plut = (uint16*) ccb->ccb_PLUTPtr;
+    int32 row_bytes = (GET_CEL_WOFFSET10(ccb) + PRE1_WOFFSET_PREFETCH) << 2;
+    int32 x, y;
+
+    plut[0] = 0;
+
+    for (x = 1; x < 32; x++)
+        plut[x] = (uint16) (color + x);
+
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < width; x++)
+        {
+            if (x == 0 || y == 0 || x == width - 1 || y == height - 1)
+                src[y * row_bytes + x] = 0;
+            else 
+                src[y * row_bytes + x] = (ubyte) (1 + ((x ^ y) & 15) + (((x >> 2) & 1) << 4));
+        }
+    }
+
+    return(ccb);
+}
+
+static void map_cel(CCB *ccb, int32 x0, int32 y0, int32 x1, int32 y1, int32 x2, int32 y2, int32 x3, int32 y3)
+{
+    Point corners[4];
+
+    corners[0].pt_X = x0; corners[0].pt_Y = y0;
+    corners[1].pt_X = x1; corners[1].pt_Y = y1;
+    corners[2].pt_X = x2; corners[2].pt_Y = y2;
+    corners[3].pt_X = x3; corners[3].pt_Y = y3;
+
+    FastMapCelf16(ccb, corners);
+}
+
+static void check_one_to_one(softcel_target_typ_ptr target)
+{
+    CCB *ccb = make_cel(16, 16, 0x0400);
+    ubyte *src = (ubyte*) ccb->ccb_SourcePtr;
+    uint16 *plut = (uint16*) ccb->ccb_PLUTPtr;
+    int32 row_bytes = (GET_CEL_WOFFSET10(ccb) + PRE1_WOFFSET_PREFETCH) << 2;
+    int32 x, y, want_written = 0;
+    uint16 want;
+
+    map_cel(ccb, F16(10), F16(20), F16(26), F16(20), F16(26), F16(36), F16(10), F16(36));
+    LAST_CEL(ccb);
+
+    softcel_clear(target, 0);
+    softcel_draw(target, ccb);
+
+    for (y = 0; y < TARGET_HEIGHT; y++)
+    {
+        for (x = 0; x < TARGET_WIDTH; x++)
+        {
+            want = 0;
+
+            if (x >= 10 && x < 26 && y >= 20 && y < 36)
+                want = plut[ src[(y - 20) * row_bytes + (x - 10)] ];
+
+            if (want)
+                want_written++;
+
+            if (target->pixels[y * TARGET_WIDTH + x] != want)
+            {
+                printf("FAIL 1:1 cel: pixel %d, %d is %04x, want %04x\n", (int) x, (int) y, 
+                    target->pixels[y * TARGET_WIDTH + x], want);
+                failures++;
+                return;
+            }
+        }
+    }
+
+    if ((int32) target->pixels_written != want_written)
+    {
+        printf("FAIL 1:1 cel: %u pixels written, want %d\n", (unsigned int) target->pixels_written, (int) want_written);
+        failures++;
+    }
+}
+
+static void expect_cost(const char *name, uint32 value, uint32 want)
+{
+    if (value != want)
+    {
+        printf("FAIL cel cost: %s is %u, want %u\n", name, (unsigned int) value, (unsigned int) want);
+        failures++;
+    }
+}
+
+static void map_square(CCB *ccb, int32 x, int32 y, int32 size)
+{
+    map_cel(ccb, F16(x), F16(y), F16(x + size), F16(y), F16(x + size), F16(y + size), F16(x), F16(y + size));
+}
+
+// Estimates for cels whose answer is known: on screen, half off the left edge, off screen and skipped
+static void check_cost_known(void)
+{
+    CCB *inside = make_cel(16, 16, 0x0400);
+    CCB *half = make_cel(16, 16, 0x0400);
+    CCB *outside = make_cel(16, 16, 0x0400);
+    CCB *skipped = make_cel(16, 16, 0x0400);
+    uint32 tx, ty, heat = 0, plut_loads = 0;
+
+    map_square(inside, 10, 20, 16);
+    map_square(half, -8, 100, 16);
+    map_square(outside, 400, 20, 16);
+    map_square(skipped, 100, 100, 16);
+    skipped->ccb_Flags |= CCB_SKIP;
+
+    LINK_CEL(inside, half);
+    LINK_CEL(half, outside);
+    LINK_CEL(outside, skipped);
+    LAST_CEL(skipped);
+
+    plut_loads += (inside->ccb_Flags & CCB_LDPLUT) ? 1 : 0;
+    plut_loads += (half->ccb_Flags & CCB_LDPLUT) ? 1 : 0;
+    plut_loads += (outside->ccb_Flags & CCB_LDPLUT) ? 1 : 0;
+
+    celcost_reset(&report);
+    celcost_add_chain(&report, DLIST_LAYER_HUD, inside, NULL);
+
+    expect_cost("cels", report.total.cels, 3);
+    expect_cost("skipped", report.total.skipped, 1);
+    expect_cost("offscreen", report.total.offscreen, 1);
+    expect_cost("plut loads", report.total.plut_loads, plut_loads);
+    expect_cost("source pixels", report.total.source_pixels, 3 * 16 * 16);
+    expect_cost("screen pixels", report.total.screen_pixels, 16 * 16 + 8 * 16);
+    expect_cost("HUD cels", report.groups[DLIST_LAYER_HUD].cels, 3);
+    expect_cost("worst pixels", report.worst_pixels, 16 * 16);
+
+    if (report.worst_ccb != inside)
+    {
+        printf("FAIL cel cost: worst cel is not the one fully on screen\n");
+        failures++;
+    }
+
+    // 3x3 tiles for the first, 3 tiles in the first column for the second
+    for (ty = 0; ty < CELCOST_TILES_Y; ty++)
+    {
+        for (tx = 0; tx < CELCOST_TILES_X; tx++)
+            heat += report.heatmap[ty][tx];
+    }
+
+    expect_cost("heatmap total", heat, 9 + 3);
+    expect_cost("heatmap tile 1, 2", report.heatmap[2][1], 1);
+    expect_cost("heatmap tile 3, 4", report.heatmap[4][3], 1);
+    expect_cost("heatmap tile 0, 13", report.heatmap[13][0], 1);
+}
+
+// What gs_play measures, every visible layer of the display list
+static void measure_cost(celcost_report_typ_ptr cost)
+{
+    uint32 i;
+    dlist_layer_typ_ptr lptr;
+
+    celcost_reset(cost);
+
+    for (i = 0; i < DLIST_MAX_LAYERS; i++)
+    {
+        lptr = dlist_get_layer(i);
+
+        if (lptr->first && !lptr->hidden)
+            celcost_add_chain(cost, i, lptr->first, lptr->last);
+    }
+}
+
+/*  The estimate against what softcel drew for the same frame. Screen pixels count
+    transparent texels and whole pixel outlines, so they only bound the pixels written. */
+static void check_cost_frame(softcel_target_typ_ptr target)
+{
+    measure_cost(&report);
+
+    expect_cost("BG cels", report.groups[DLIST_LAYER_BG].cels, 1);
+    expect_cost("3D cels", report.groups[DLIST_LAYER_3D].cels, POLY_COUNT);
+    expect_cost("HUD cels", report.groups[DLIST_LAYER_HUD].cels, SPRITE_COUNT);
+    expect_cost("cels and skipped", report.total.cels + report.total.skipped,
+        target->cels_drawn + target->cels_skipped + target->cels_unsupported);
+    expect_cost("BG screen pixels", report.groups[DLIST_LAYER_BG].screen_pixels, TARGET_WIDTH * TARGET_HEIGHT);
+
+    printf("softcel: cel cost estimates %u screen pixels, softcel wrote %u\n",
+        (unsigned int) report.total.screen_pixels, (unsigned int) target->pixels_written);
+
+    if (report.total.screen_pixels < target->pixels_written || 
+        report.total.screen_pixels > target->pixels_written + (target->pixels_written >> 1))
+    {
+        printf("FAIL cel cost: estimate is not within 50%% above the pixels written\n");
+        failures++;
+    }
+}
+
+// Background, perspective mapped polygons in the 3D layer and unscaled HUD sprites
+static void build_frame(void)
+{
+    CCB *bg = make_cel(64, 64, 0x0000);
+    CCB *textures[4];
+    CCB *first = NULL;
+    CCB *prev = NULL;
+    CCB *ccb;
+    int32 i, x, y, w, h, lean;
+
+    dlist_reset();
+
+    bg->ccb_Flags |= CCB_BGND;
+    map_cel(bg, 0, 0, F16(TARGET_WIDTH), 0, F16(TARGET_WIDTH), F16(TARGET_HEIGHT), 0, F16(TARGET_HEIGHT));
+    dlist_append(DLIST_LAYER_BG, bg, bg);
+
+    for (i = 0; i < 4; i++)
+        textures[i] = make_cel(32, 32, (uint16) (0x0800 * (1 + i)));
+
+    // Polygons share a few textures, as the game's do
+    for (i = 0; i < POLY_COUNT; i++)
+    {
+        ccb = create_coded_cel8(32, 32, FALSE);
+        ccb->ccb_SourcePtr = textures[i & 3]->ccb_SourcePtr;
+        ccb->ccb_PLUTPtr = textures[i & 3]->ccb_PLUTPtr;
+        ccb->ccb_PIXC = textures[i & 3]->ccb_PIXC;
+        x = F16(next_random(TARGET_WIDTH + 64) - 64) + next_random(65536);
+        y = F16(next_random(TARGET_HEIGHT + 64) - 64) + next_random(65536);
+        w = F16(16 + next_random(80));
+        h = F16(16 + next_random(60));
+        lean = F16(next_random(24));
+
+        // Trapezoid, narrower at the top like a receding polygon
+        map_cel(ccb, x + lean, y, x + w - lean, y, x + w, y + h, x, y + h);
+
+        if (prev)
+            LINK_CEL(prev, ccb);
+        else 
+            first = ccb;
+
+        prev = ccb;
+    }
+
+    dlist_append(DLIST_LAYER_3D, first, prev);
+
+    for (i = 0; i < SPRITE_COUNT; i++)
+    {
+        ccb = make_cel(16, 16, 0x7000);
+        x = F16(next_random(TARGET_WIDTH - 16));
+        y = F16(next_random(TARGET_HEIGHT - 16));
+        map_cel(ccb, x, y, x + F16(16), y, x + F16(16), y + F16(16), x, y + F16(16));
+        dlist_append(DLIST_LAYER_HUD, ccb, ccb);
+    }
+}
+
+// Each damaged copy must be refused, name describes the damage
+static void expect_refused(const char *name, uint32 *data, uint32 size)
+{
+    static CCB ccbs[CAPTURE_MAX_CCBS];
+
+    if (capture_load(data, size, ccbs, CAPTURE_MAX_CCBS, NULL) != NULL)
+    {
+        printf("FAIL capture_load accepted %s\n", name);
+        failures++;
+    }
+}
+
+static void check_refused(void *kept, uint32 size)
+{
+    static uint32 copy[CAPTURE_BUFFER_SIZE >> 2];
+    capture_header_typ_ptr header = (capture_header_typ_ptr) copy;
+    capture_ccb_typ_ptr records = (capture_ccb_typ_ptr) (header + 1);
+    capture_chunk_typ_ptr table;
+
+    memcpy((void*)copy, kept, size);
+    table = (capture_chunk_typ_ptr) &records[header->ccb_count];
+
+    records[1].next = 0;
+    expect_refused("a backward link", copy, size);
+
+    memcpy((void*)copy, kept, size);
+    records[0].next = header->ccb_count;
+    expect_refused("a link past the last CCB", copy, size);
+
+    memcpy((void*)copy, kept, size);
+    records[0].source += 4;
+    expect_refused("a source offset inside a chunk", copy, size);
+
+    memcpy((void*)copy, kept, size);
+    records[0].plut = header->data_size;
+    expect_refused("a PLUT offset past the data", copy, size);
+
+    memcpy((void*)copy, kept, size);
+    table[0].size = header->data_size;
+    table[0].offset = 4;
+    expect_refused("a chunk running past the data", copy, size);
+
+    memcpy((void*)copy, kept, size);
+    table[0].size = 8;
+    expect_refused("a source chunk smaller than its cel", copy, size);
+
+    memcpy((void*)copy, kept, size);
+    header->data_size += 4;
+    expect_refused("data past the end of the file", copy, size);
+
+    memcpy((void*)copy, kept, size);
+    records[0].layer = DLIST_MAX_LAYERS;
+    expect_refused("an unknown layer", copy, size);
+}
+
+// The estimator alone over the built frame, nothing drawn
+static void bench_cost(void)
+{
+    clock_t start;
+    double seconds;
+    uint32 frames = 0;
+
+    start = clock();
+
+    do 
+    {
+        measure_cost(&report);
+        frames++;
+        seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+    } while (seconds < BENCH_SECONDS);
+
+    printf("softcel: cel cost alone, %.0f frames per second, %.2f us per cel\n", frames / seconds,
+        seconds * 1e6 / frames / (report.total.cels + report.total.skipped));
+}
+
+static void bench(softcel_target_typ_ptr target, void *data, uint32 size)
+{
+    clock_t start;
+    double seconds;
+    uint32 frames = 0;
+    uint32 written = 0;
+
+    start = clock();
+
+    do 
+    {
+        softcel_clear(target, 0);
+
+        if (capture_replay(data, size, target, NULL) < 0)
+        {
+            printf("Error - Capture could not be replayed\n");
+            failures++;
+            return;
+        }
+
+        written += target->pixels_written;
+        frames++;
+        seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+    } while (seconds < BENCH_SECONDS);
+
+    printf("softcel: %u cels, %.0f frames per second, %.1f million pixels per second\n", 
+        (unsigned int) (target->cels_drawn + target->cels_skipped + target->cels_unsupported), 
+        frames / seconds, written / seconds / 1e6);
+}
+
+int main(int argc, char **argv)
+{
+    softcel_target_typ target;
+    void *kept;
+    uint32 size;
+    int32 read;
+
+    target.pixels = pixels;
+    target.width = TARGET_WIDTH;
+    target.height = TARGET_HEIGHT;
+
+    check_one_to_one(&target);
+    check_cost_known();
+
+    build_frame();
+
+    softcel_clear(&target, 0);
+    softcel_draw(&target, dlist_link());
+    memcpy((void*)expected, (void*)pixels, sizeof(pixels));
+
+    check_cost_frame(&target);
+    celcost_print(&report, "softcel bench frame");
+    bench_cost();
+
+    if (!capture_init() || !capture_frame(1, 1) || (kept = capture_kept(&size)) == NULL)
+    {
+        printf("Error - Frame could not be captured\n");
+        return(1);
+    }
+
+    memcpy((void*)replay_data, kept, size);
+    softcel_clear(&target, 0);
+
+    celcost_reset(&replay_report);
+
+    if (capture_replay(replay_data, size, &target, &replay_report) < 0 || memcmp(expected, pixels, sizeof(pixels)) != 0)
+    {
+        printf("FAIL replay does not match drawing the display list\n");
+        failures++;
+    }
+
+    if (memcmp((void*)&replay_report.total, (void*)&report.total, sizeof(celcost_group_typ)) != 0 ||
+        memcmp((void*)replay_report.heatmap, (void*)report.heatmap, sizeof(report.heatmap)) != 0)
+    {
+        printf("FAIL cel cost of the replay differs from the display list\n");
+        failures++;
+    }
+
+    check_refused(kept, size);
+
+    if (argc > 1)
+    {
+        read = capture_read(argv[1], replay_data, sizeof(replay_data));
+
+        if (read <= 0)
+        {
+            printf("Error - Could not read %s\n", argv[1]);
+            return(1);
+        }
+
+        size = (uint32) read;
+    }
+
+    bench(&target, replay_data, size);
+    capture_free();
+
+    printf("softcel: %s\n", failures ? "FAILED" : "ok");
+
+    return(failures != 0);
+}
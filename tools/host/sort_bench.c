@@ -0,0 +1,261 @@
+/**
+ * @file sort_bench.c
+ * @brief Checks sort_polys against the bubble sort it replaced and times both.
+ *
+ * An object of small camera facing quads at random depths is queued with
+ * add_obj. Depths are rounded so that many polygons tie. The 3D layer order
+ * left by end_3d must match a bubble sort, which is stable. On the first frame
+ * the bubble sort starts from queue order. On following frames a few quads move
+ * and it starts from the previous frame's order, since sort_polys keeps tied
+ * polygons where they were last frame.
+ *
+ * Frames of 30, 120 and 1000 polygons are then timed three ways: sort_polys
+ * reusing last frame's order, sort_polys with the order thrown away so the
+ * bucket pass runs, and the old bubble sort. Each frame includes begin_3d and
+ * add_obj, which is the same for all three.
+ *
+ * Build with RQUEUE_BUDGET of at least 1000.
+ */
+
+#include "threed.h"
+#include "rqueue.h"
+#include "dlist.h"
+#include "fixmath.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define CHECK_POLYS 200
+#define CHECK_FRAMES 8
+#define BENCH_SECONDS 0.25
+#define QUAD_HALF 0x0C00        // 16.16 half width of each quad
+#define DEPTH_STEP 0x1000       // Depths are multiples of this, so polygons tie
+
+#define SORT_REUSED 0
+#define SORT_BUCKET 1
+#define SORT_BUBBLE 2
+
+static polygon_typ_ptr bubble_items[1024];
+static uint32 seed = 12345;
+static int failures = 0;
+
+static int32 next_random(int32 range)
+{
+    seed = seed * 1664525 + 1013904223;
+    return((int32) ((seed >> 8) % (uint32) range));
+}
+
+// Camera facing quad centered on x, y at depth z
+static void place_quad(object_typ_ptr obj, uint32 index, frac16 x, frac16 y, frac16 z)
+{
+    vertex_typ_ptr v = &obj->vertex_def.vertices[index << 2];
+
+    v[0].vertex[X] = x - QUAD_HALF; v[0].vertex[Y] = y + QUAD_HALF; v[0].vertex[Z] = z;
+    v[1].vertex[X] = x + QUAD_HALF; v[1].vertex[Y] = y + QUAD_HALF; v[1].vertex[Z] = z;
+    v[2].vertex[X] = x + QUAD_HALF; v[2].vertex[Y] = y - QUAD_HALF; v[2].vertex[Z] = z;
+    v[3].vertex[X] = x - QUAD_HALF; v[3].vertex[Y] = y - QUAD_HALF; v[3].vertex[Z] = z;
+}
+
+// Depth 1 - 20 units, past the bucket range so the last bucket fills too
+static void place_random_quad(object_typ_ptr obj, uint32 index)
+{
+    frac16 z = ONE_F16 + next_random(19 * (ONE_F16 / DEPTH_STEP)) * DEPTH_STEP;
+    frac16 x = FIX_MUL(next_random(ONE_F16) - ONE_F16 / 2, z) * 3 >> 2;
+    frac16 y = FIX_MUL(next_random(ONE_F16) - ONE_F16 / 2, z) * 3 >> 3;
+
+    place_quad(obj, index, x, y, z);
+}
+
+static object_typ_ptr make_obj(uint32 poly_count)
+{
+    object_typ_ptr obj = (object_typ_ptr) AllocMem(sizeof(object_typ), MEMTYPE_FILL);
+    uint32 i, k;
+
+    obj->version = 1;
+    obj->shape_version = 1;
+    obj->vertex_def.vertex_count = poly_count << 2;
+    obj->vertex_def.vertices = (vertex_typ_ptr) AllocMem(sizeof(vertex_typ) * (poly_count << 2), MEMTYPE_FILL);
+    obj->camera_verts = (vec3f16*) AllocMem(sizeof(vec3f16) * (poly_count << 2), MEMTYPE_FILL);
+    obj->screen_verts = (Point*) AllocMem(sizeof(Point) * (poly_count << 2), MEMTYPE_FILL);
+    obj->poly_count = poly_count;
+    obj->polygons = (polygon_typ_ptr) AllocMem(sizeof(polygon_typ) * poly_count, MEMTYPE_FILL);
+
+    for (i = 0; i < poly_count; i++)
+    {
+        for (k = 0; k < 4; k++)
+            obj->polygons[i].vertex_lut[k] = (i << 2) + k;
+
+        obj->polygons[i].parent = obj;
+        obj->polygons[i].ccb = CreateCel(1, 1, 8, CREATECEL_CODED, NULL);
+        place_random_quad(obj, i);
+    }
+
+    return(obj);
+}
+
+// The sort sort_polys replaced, largest avgz first
+static void bubble_sort(polygon_typ_ptr *items, uint32 n)
+{
+    uint32 i, j;
+    polygon_typ_ptr temp;
+
+    for (i = 0; i < n; i++)
+    {
+        for (j = 0; j < n - 1; j++)
+        {
+            if (items[j]->avgz < items[j+1]->avgz)
+            {
+                temp = items[j];
+                items[j] = items[j+1];
+                items[j+1] = temp;
+            }
+        }
+    }
+}
+
+// add_obj queues an object's polygons in index order
+static void queue_order(object_typ_ptr obj)
+{
+    uint32 i;
+
+    for (i = 0; i < obj->poly_count; i++)
+        bubble_items[i] = &obj->polygons[i];
+}
+
+// bubble_items holds the order to start from, and the expected order after
+static void check_frame(object_typ_ptr obj, uint32 frame)
+{
+    CCB *ccb;
+    uint32 i;
+
+    begin_3d();
+    add_obj(obj, FALSE);
+    sort_polys();
+    end_3d();
+
+    if (render_stats.polys_recomputed + render_stats.polys_reused != obj->poly_count)
+    {
+        printf("FAIL frame %u: %u polygons queued, want %u\n", (unsigned int) frame,
+            (unsigned int) (render_stats.polys_recomputed + render_stats.polys_reused), (unsigned int) obj->poly_count);
+        failures++;
+        return;
+    }
+
+    bubble_sort(bubble_items, obj->poly_count);
+
+    ccb = dlist_get_layer(DLIST_LAYER_3D)->first;
+
+    for (i = 0; i < obj->poly_count; i++)
+    {
+        if (ccb != bubble_items[i]->ccb)
+        {
+            printf("FAIL frame %u: position %u differs from the bubble sort\n", (unsigned int) frame, (unsigned int) i);
+            failures++;
+            return;
+        }
+
+        ccb = ccb->ccb_NextPtr;
+    }
+}
+
+static void check_order(void)
+{
+    object_typ_ptr obj = make_obj(CHECK_POLYS);
+    uint32 frame, i;
+
+    queue_order(obj);
+
+    for (frame = 0; frame < CHECK_FRAMES; frame++)
+    {
+        // First frame runs the bucket pass, the rest start from the previous order
+        if (frame > 0)
+        {
+            for (i = 0; i < CHECK_POLYS / 10; i++)
+                place_random_quad(obj, next_random(CHECK_POLYS));
+
+            MARK_OBJ_DIRTY(obj);
+        }
+
+        check_frame(obj, frame);
+    }
+}
+
+static double time_frames(object_typ_ptr obj, uint32 kind)
+{
+    clock_t start, limit;
+    uint32 frames = 0;
+    uint32 i;
+    double seconds;
+
+    limit = (clock_t) (BENCH_SECONDS * CLOCKS_PER_SEC);
+    start = clock();
+
+    do
+    {
+        begin_3d();
+        add_obj(obj, FALSE);
+
+        switch(kind)
+        {
+        case SORT_REUSED:
+            sort_polys();
+            break;
+
+        case SORT_BUCKET:
+            for (i = 0; i < obj->poly_count; i++)
+                obj->polygons[i].sort_stamp = 0;
+
+            sort_polys();
+            break;
+
+        case SORT_BUBBLE:
+            queue_order(obj);
+            bubble_sort(bubble_items, obj->poly_count);
+            break;
+        }
+
+        frames++;
+    } while (clock() - start < limit);
+
+    seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    return(seconds * 1e6 / frames);
+}
+
+static void bench(uint32 poly_count)
+{
+    object_typ_ptr obj = make_obj(poly_count);
+    double reused, bucket, bubble;
+
+    // Builds the object cache, later frames only queue
+    begin_3d();
+    add_obj(obj, FALSE);
+    sort_polys();
+
+    reused = time_frames(obj, SORT_REUSED);
+    bucket = time_frames(obj, SORT_BUCKET);
+    bubble = time_frames(obj, SORT_BUBBLE);
+
+    printf("%4u polys: reused %.2f us, bucket %.2f us, bubble %.2f us per frame\n", (unsigned int) poly_count,
+        reused, bucket, bubble);
+}
+
+int main(void)
+{
+    camera.world_x = 0;
+    camera.world_y = 0;
+    camera.world_z = 0;
+
+    init_3d();
+
+    check_order();
+
+    bench(30);
+    bench(120);
+    bench(1000);
+
+    printf("sort: %s\n", failures ? "FAILED" : "ok");
+
+    return(failures != 0);
+}
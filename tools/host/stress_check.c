@@ -0,0 +1,322 @@
+/**
+ * @file stress_check.c
+ * @brief Runs the enemy and spike pools at the PROFILE_STRESS capacities.
+ *
+ * Spikers are first left alone on the level until every corridor holds a spike,
+ * more than the default MAX_SPIKES, and the spikes are shot down again. Then
+ * enemies are spawned until every slot is live, and spawning continues at the
+ * cap while enemies are destroyed at random and tankers split. After every step:
+ *  - get_spike_count agrees with the active spikes
+ *  - a spawn with every slot live leaves every enemy as it was, so a live slot
+ *    is never handed out twice
+ *  - a spawn after a destroy takes the slot that was freed
+ *
+ * Finally the enemy update is timed with every slot live.
+ *
+ * Build with -DPROFILE_STRESS.
+ */
+
+#include "host_play.h"
+
+#include <string.h>
+#include <time.h>
+
+#define FRAME_MSEC 16
+#define FRAME_DELTA 256
+#define FILL_FRAMES 2000
+#define CHURN_FRAMES 3000
+#define SPIKE_FRAMES 20000
+#define BENCH_SECONDS 0.25
+
+static enemy_typ saved[MAX_ENEMIES];
+static uint32 peak_enemies = 0;
+static uint32 peak_spikes = 0;
+static uint32 destroyed = 0;
+static int failures = 0;
+
+static uint32 next_random(uint32 range)
+{
+    return((uint32) rand() % range);
+}
+
+static uint32 live_enemies(void)
+{
+    uint32 i, live = 0;
+
+    for (i = 0; i < MAX_ENEMIES; i++)
+    {
+        if (enemies[i].state != ES_INACTIVE)
+            ++live;
+    }
+
+    return(live);
+}
+
+static uint32 active_spikes(void)
+{
+    uint32 i, active = 0;
+
+    for (i = 0; i < MAX_SPIKES; i++)
+    {
+        if (spikes[i].active)
+            ++active;
+    }
+
+    return(active);
+}
+
+static void check_counts(const char *phase, uint32 frame)
+{
+    uint32 live = live_enemies();
+    uint32 active = active_spikes();
+
+    if (live > peak_enemies)
+        peak_enemies = live;
+
+    if (active > peak_spikes)
+        peak_spikes = active;
+
+    if (active != get_spike_count())
+    {
+        if (failures < 20)
+        {
+            printf("FAIL %s frame %u: %u spikes active, get_spike_count says %u\n", phase, (unsigned int) frame,
+                (unsigned int) active, (unsigned int) get_spike_count());
+        }
+
+        failures++;
+    }
+}
+
+// With every slot live a spawn must be refused and leave every enemy alone
+static void check_full_spawn(uint32 frame)
+{
+    uint32 i;
+
+    memcpy((void*)saved, (void*)enemies, sizeof(enemies));
+    spawn_next_enemy();
+
+    for (i = 0; i < MAX_ENEMIES; i++)
+    {
+        if (enemies[i].state != saved[i].state || enemies[i].enemy_type != saved[i].enemy_type ||
+            enemies[i].corridor_index != saved[i].corridor_index)
+        {
+            if (failures < 20)
+                printf("FAIL full frame %u: spawn changed live slot %u\n", (unsigned int) frame, (unsigned int) i);
+
+            failures++;
+            return;
+        }
+    }
+}
+
+// Destroy one active enemy at random and spawn straight into its slot
+static void check_reuse(uint32 frame)
+{
+    uint32 i, slot;
+
+    slot = next_random(MAX_ENEMIES);
+
+    for (i = 0; i < MAX_ENEMIES && enemies[slot].state != ES_ACTIVE; i++)
+        slot = (slot + 1) % MAX_ENEMIES;
+
+    if (i == MAX_ENEMIES)
+        return;
+
+    // No payload, a tanker would take the slot with its child
+    destroy_enemy(&enemies[slot], FALSE);
+    ++destroyed;
+
+    spawn_next_enemy();
+
+    if (enemies[slot].state != ES_ACTIVE)
+    {
+        if (failures < 20)
+            printf("FAIL churn frame %u: freed slot %u was not reused\n", (unsigned int) frame, (unsigned int) slot);
+
+        failures++;
+    }
+}
+
+static void step_frame(void)
+{
+    host_msec += FRAME_MSEC;
+    update_enemies(FRAME_DELTA);
+}
+
+static void fill(uint32 number)
+{
+    uint32 frame;
+
+    for (frame = 0; frame < FILL_FRAMES && live_enemies() < MAX_ENEMIES; frame++)
+    {
+        spawn_next_enemy();
+        step_frame();
+        check_counts("fill", frame);
+    }
+
+    if (live_enemies() < MAX_ENEMIES)
+    {
+        printf("FAIL level %u: %u of %u enemy slots live after %u frames\n", (unsigned int) number,
+            (unsigned int) live_enemies(), (unsigned int) MAX_ENEMIES, (unsigned int) frame);
+        failures++;
+    }
+}
+
+static void churn(void)
+{
+    uint32 frame, i, k;
+
+    for (frame = 0; frame < CHURN_FRAMES; frame++)
+    {
+        if (live_enemies() == MAX_ENEMIES)
+            check_full_spawn(frame);
+        else
+            spawn_next_enemy();
+
+        step_frame();
+        check_counts("churn", frame);
+
+        if (live_enemies() == MAX_ENEMIES && (frame & 3) == 0)
+            check_reuse(frame);
+
+        // Shoot a few enemies, tankers split
+        for (k = next_random(4); k > 0; k--)
+        {
+            i = next_random(MAX_ENEMIES);
+
+            if (enemies[i].state == ES_ACTIVE)
+            {
+                destroy_enemy(&enemies[i], TRUE);
+                ++destroyed;
+            }
+        }
+
+        // And a spike now and then
+        if ((frame & 7) == 0)
+        {
+            i = next_random(MAX_SPIKES);
+
+            if (spikes[i].active)
+                damage_spike(&spikes[i]);
+        }
+
+        check_counts("churn shots", frame);
+    }
+}
+
+// Keep only spikers so corridors stay free for them, until each corridor has a spike
+static void lay_spikes(uint32 number, uint32 corridor_count)
+{
+    uint32 frame, i;
+
+    for (frame = 0; frame < SPIKE_FRAMES && active_spikes() < corridor_count; frame++)
+    {
+        spawn_next_enemy();
+        step_frame();
+
+        for (i = 0; i < MAX_ENEMIES; i++)
+        {
+            if (enemies[i].state == ES_ACTIVE && enemies[i].enemy_type != SPIKER)
+                destroy_enemy(&enemies[i], FALSE);
+        }
+
+        check_counts("spikes", frame);
+    }
+
+    if (active_spikes() < corridor_count)
+    {
+        printf("FAIL level %u: %u spikes laid on %u corridors after %u frames\n", (unsigned int) number,
+            (unsigned int) active_spikes(), (unsigned int) corridor_count, (unsigned int) frame);
+        failures++;
+    }
+
+    // Shoot them all down, the slots return to the pool
+    for (frame = 0; frame < 64 && active_spikes() > 0; frame++)
+    {
+        for (i = 0; i < MAX_SPIKES; i++)
+        {
+            if (spikes[i].active)
+                damage_spike(&spikes[i]);
+        }
+
+        check_counts("spikes shot", frame);
+    }
+
+    if (active_spikes() != 0)
+    {
+        printf("FAIL level %u: spikes left after shooting\n", (unsigned int) number);
+        failures++;
+    }
+}
+
+static double time_frames(void)
+{
+    clock_t start, limit;
+    uint32 frames = 0;
+
+    limit = (clock_t) (BENCH_SECONDS * CLOCKS_PER_SEC);
+    start = clock();
+
+    do
+    {
+        spawn_next_enemy();
+        step_frame();
+        frames++;
+    } while (clock() - start < limit);
+
+    return((double) (clock() - start) / CLOCKS_PER_SEC * 1e6 / frames);
+}
+
+static void stress_level(uint32 number)
+{
+    level_typ_ptr level = host_load_level(number);
+    double frame_us;
+
+    if (!level)
+    {
+        failures++;
+        return;
+    }
+
+    // Every enemy type may spawn
+    current_level = 99;
+    peak_enemies = peak_spikes = destroyed = 0;
+
+    clear_hostiles();
+
+    lay_spikes(number, level->obj->poly_count);
+    clear_hostiles();
+
+    fill(number);
+    churn();
+
+    // Pools are reset with the level and fill again from empty
+    clear_hostiles();
+
+    if (live_enemies() != 0 || active_spikes() != 0)
+    {
+        printf("FAIL level %u: slots still live after clear_hostiles\n", (unsigned int) number);
+        failures++;
+    }
+
+    fill(number);
+    frame_us = time_frames();
+
+    printf("stress: level %u, peak %u of %u enemies, %u of %u spikes, %u destroyed, update %.2f us per frame\n",
+        (unsigned int) number, (unsigned int) peak_enemies, (unsigned int) MAX_ENEMIES, (unsigned int) peak_spikes,
+        (unsigned int) MAX_SPIKES, (unsigned int) destroyed, frame_us);
+}
+
+int main(void)
+{
+    srand(3);
+    init_enemies();
+
+    stress_level(5);
+    stress_level(20);
+
+    printf("stress: %s\n", failures ? "FAILED" : "ok");
+
+    return(failures != 0);
+}
@@ -0,0 +1,180 @@
+/**
+ * @file trig_check.c
+ * @brief Checks the trig.c tables against the math folio and times them.
+ *
+ * Without a log the lookups are compared against the exact result rounded to
+ * 16.16. Given the path of a log printed by folioref_dump on a console, every
+ * sine, cosine and arctangent line is compared against the folio result instead.
+ * Either way the worst error is reported, then calls per second for each lookup.
+ *
+ * Usage: trig_check [folio log]
+ */
+
+#include "trig.h"
+#include "folioref.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#define SIN_TOLERANCE 4         // 16.16 units, the generator reports 2 against exact
+#define ATAN2_TOLERANCE 64      // Angle units, 1 / 262144 of a turn
+#define BENCH_CALLS 20000000
+
+static int32 worst[FOLIOREF_KINDS];
+
+static frac16 lookup(uint32 kind, frac16 a, frac16 b)
+{
+    if (kind == FOLIOREF_SIN)
+        return(sin_f16(a));
+
+    if (kind == FOLIOREF_COS)
+        return(cos_f16(a));
+
+    return(atan2_f16(a, b));
+}
+
+// Exact result rounded the way the folio rounds
+static frac16 exact(uint32 kind, frac16 a, frac16 b)
+{
+    double turn = 2.0 * M_PI / 16777216.0;
+    double angle;
+
+    if (kind == FOLIOREF_SIN)
+        return((frac16) floor(sin(a * turn) * 65536.0 + 0.5));
+
+    if (kind == FOLIOREF_COS)
+        return((frac16) floor(cos(a * turn) * 65536.0 + 0.5));
+
+    if (a == 0 && b == 0)
+        return(0);
+
+    angle = atan2((double) b, (double) a);
+
+    if (angle < 0)
+        angle += 2.0 * M_PI;
+
+    return((frac16) floor(angle / turn + 0.5) & 0xFFFFFF);
+}
+
+static void record(uint32 kind, frac16 got, frac16 want)
+{
+    int32 error = got - want;
+
+    // Angles wrap at a full turn
+    if (kind == FOLIOREF_ATAN2)
+        error = ((error + 0x800000) & 0xFFFFFF) - 0x800000;
+
+    if (error < 0)
+        error = -error;
+
+    if (error > worst[kind])
+        worst[kind] = error;
+}
+
+static int check_exact(void)
+{
+    uint32 kind, i;
+    frac16 a, b;
+
+    for (kind = FOLIOREF_SIN; kind <= FOLIOREF_ATAN2; kind++)
+    {
+        for (i = 0; i < FOLIOREF_COUNT; i++)
+        {
+            folioref_input(kind, i, &a, &b);
+            record(kind, lookup(kind, a, b), exact(kind, a, b));
+        }
+    }
+
+    return(FOLIOREF_COUNT * 3);
+}
+
+static int check_log(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[128];
+    unsigned int kind, index, a, b, result;
+    int compared = 0;
+
+    if (f == NULL)
+    {
+        printf("Error - Could not open %s\n", path);
+        return(-1);
+    }
+
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        if (sscanf(line, "FREF %u %u %x %x %x", &kind, &index, &a, &b, &result) != 5)
+            continue;
+
+        if (kind < FOLIOREF_SIN || kind > FOLIOREF_ATAN2)
+            continue;
+
+        record(kind, lookup(kind, (frac16) a, (frac16) b), (frac16) result);
+        compared++;
+    }
+
+    fclose(f);
+
+    return(compared);
+}
+
+static void bench(uint32 kind, const char *name)
+{
+    volatile frac16 sink = 0;
+    frac16 a = 0x12345;
+    frac16 b = 0x54321;
+    clock_t start;
+    double seconds;
+    int32 i;
+
+    start = clock();
+
+    for (i = 0; i < BENCH_CALLS; i++)
+    {
+        sink += lookup(kind, a, b);
+        a = (a + 0x3F1D) & 0xFFFFFF;
+        b = ((b + 0x1B07) & 0xFFFFF) - 0x80000;
+    }
+
+    seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    if (seconds <= 0)
+        seconds = 1e-9;
+
+    printf("%-6s %.1f million calls per second\n", name, BENCH_CALLS / seconds / 1e6);
+}
+
+int main(int argc, char **argv)
+{
+    int compared;
+    int failed;
+
+    if (argc > 1)
+        compared = check_log(argv[1]);
+    else
+        compared = check_exact();
+
+    if (compared <= 0)
+    {
+        printf("Error - No folio results in %s\n", argv[1]);
+        return(1);
+    }
+
+    printf("trig: %d results compared against %s\n", compared, (argc > 1) ? "the folio" : "exact values");
+    printf("sin    max error %d / 65536\n", (int) worst[FOLIOREF_SIN]);
+    printf("cos    max error %d / 65536\n", (int) worst[FOLIOREF_COS]);
+    printf("atan2  max error %d angle units\n", (int) worst[FOLIOREF_ATAN2]);
+
+    bench(FOLIOREF_SIN, "sin");
+    bench(FOLIOREF_COS, "cos");
+    bench(FOLIOREF_ATAN2, "atan2");
+
+    failed = worst[FOLIOREF_SIN] > SIN_TOLERANCE || worst[FOLIOREF_COS] > SIN_TOLERANCE || 
+        worst[FOLIOREF_ATAN2] > ATAN2_TOLERANCE;
+
+    printf("trig: %s\n", failed ? "FAILED" : "ok");
+
+    return(failed);
+}